@@ -1,54 +1,177 @@
 #pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace self {
 
-/* простенькая реализация std::array, обертка RAII над статическим массивом */
-template <typename T, size_t N>
+/* размер кэш-линии, по нему выравниваются CacheAlignedArray */
+inline constexpr size_t kCacheLineSize = 64;
+/*
+    выравнивание SimdAlignedArray: ширина регистра AVX-512, ее хватает и для SSE, и для AVX.
+    Значение не зависит от флагов -m, иначе один и тот же тип имел бы разное
+    выравнивание в единицах трансляции, собранных с разными флагами (нарушение ODR)
+*/
+inline constexpr size_t kSimdWidth = 64;
+
+/*
+    простенькая реализация std::array, обертка RAII над статическим массивом.
+    Array является агрегатом, поэтому его можно инициализировать как обычный
+    массив: self::Array<int, 3> arr = {1, 2, 3};
+    Все методы constexpr, так что таблицы, посчитанные на этапе компиляции,
+    попадают в .rodata и не инициализируются при старте программы.
+    Align позволяет выровнять массив сильнее, чем требует T (см. CacheAlignedArray)
+*/
+template <typename T, size_t N, size_t Align = alignof(T)>
 class Array {
+    static_assert(Align >= alignof(T), "Align must not weaken alignment of T");
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
 public:
-    Array() = default;
-public:
-    constexpr size_t Size() const { return N; }
-    T& operator[](size_t index) {
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t Size() noexcept { return N; }
+    static constexpr size_t Alignment() noexcept { return Align; }
+
+    constexpr T& operator[](size_t index) noexcept {
         assert(index < N);
         return data_[index];
     }
-    const T& operator[](size_t index) const {
-        return const_cast<Array&>(*this)[index];
-    }
-    T& At(size_t index) {
+    constexpr const T& operator[](size_t index) const noexcept {
         assert(index < N);
         return data_[index];
     }
-    const T& At(size_t index) const {
-        return const_cast<Array&>(*this)[index];
+    constexpr T& At(size_t index) {
+        if (index >= N) {
+            throw std::out_of_range("Array index out of range");
+        }
+        return data_[index];
+    }
+    constexpr const T& At(size_t index) const {
+        if (index >= N) {
+            throw std::out_of_range("Array index out of range");
+        }
+        return data_[index];
     }
 
-    using iterator = T*;
-    using const_iterator = const T*;
+    constexpr T* Data() noexcept {
+        return data_;
+    }
+    constexpr const T* Data() const noexcept {
+        return data_;
+    }
 
-    iterator begin() noexcept {
-        return data_ + 0;
+    constexpr iterator begin() noexcept {
+        return data_;
     }
-    iterator end() noexcept {
+    constexpr iterator end() noexcept {
         return data_ + N;
     }
-    const_iterator begin() const noexcept {
-        return const_cast<Array&>(*this).begin();
+    constexpr const_iterator begin() const noexcept {
+        return data_;
     }
-    const_iterator end() const noexcept {
-        return const_cast<Array&>(*this).end();
+    constexpr const_iterator end() const noexcept {
+        return data_ + N;
     }
-    const_iterator cbegin() const noexcept {
+    constexpr const_iterator cbegin() const noexcept {
         return begin();
     }
-    const_iterator cend() const noexcept {
+    constexpr const_iterator cend() const noexcept {
         return end();
     }
-    
-private:
-    T data_[N];
+
+    /*
+        Fill, Swap и operator== написаны простыми циклами по выровненному
+        массиву фиксированной длины — на -O2 компилятор разворачивает их
+        в векторные инструкции, а в constant evaluation они остаются обычным кодом
+    */
+    constexpr void Fill(const T& value) {
+        std::fill_n(data_, N, value);
+    }
+
+    constexpr void Swap(Array& other) noexcept(std::is_nothrow_swappable_v<T>) {
+        std::swap_ranges(data_, data_ + N, other.data_);
+    }
+
+    /*
+        открытое поле нужно для агрегатной инициализации (как в std::array),
+        напрямую к нему обращаться не стоит.
+        Для N == 0 хранится один элемент, чтобы не объявлять массив нулевой длины
+    */
+    alignas(Align) T data_[N == 0 ? 1 : N];
 };
 
+/* массив, выровненный по кэш-линии: не делит линию с соседними данными */
+template <typename T, size_t N>
+using CacheAlignedArray = Array<T, N, std::max(kCacheLineSize, alignof(T))>;
+
+/* массив, выровненный по ширине SIMD-регистра: позволяет выровненные загрузки */
+template <typename T, size_t N>
+using SimdAlignedArray = Array<T, N, std::max(kSimdWidth, alignof(T))>;
+
+template <typename T, size_t N, size_t Align>
+constexpr void swap(Array<T, N, Align>& lhs, Array<T, N, Align>& rhs)
+        noexcept(noexcept(lhs.Swap(rhs))) {
+    lhs.Swap(rhs);
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator==(const Array<T, N, Align>& lhs, const Array<T, N, Align>& rhs) {
+    /*
+        если у T нет паддинга и "особых" значений (как -0.0 и NaN у float),
+        равенство объектов равносильно равенству байт, и memcmp сравнивает
+        сразу по ширине вектора
+    */
+    if constexpr (std::has_unique_object_representations_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            return std::memcmp(lhs.Data(), rhs.Data(), sizeof(T) * N) == 0;
+        }
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator!=(const Array<T, N, Align>& lhs, const Array<T, N, Align>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator<(const Array<T, N, Align>& lhs, const Array<T, N, Align>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator<=(const Array<T, N, Align>& lhs, const Array<T, N, Align>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator>(const Array<T, N, Align>& lhs, const Array<T, N, Align>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, size_t N, size_t Align>
+constexpr bool operator>=(const Array<T, N, Align>& lhs, const Array<T, N, Align>& rhs) {
+    return !(lhs < rhs);
+}
+
+/*
+    строит массив на этапе компиляции: arr[i] = gen(i).
+    constexpr auto kSquares = self::MakeArray<int, 16>([](size_t i) { return int(i * i); });
+*/
+template <typename T, size_t N, typename Generator>
+constexpr Array<T, N> MakeArray(Generator gen) {
+    Array<T, N> result{};
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = gen(i);
+    }
+    return result;
+}
+
 } // self
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "bench.h"
+
+#include "array/array.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+namespace bench {
+namespace {
+
+/* у Array размер задается на этапе компиляции, поэтому набор размеров фиксирован */
+constexpr size_t kSmall = 16;
+constexpr size_t kMedium = 1'024;
+constexpr size_t kLarge = 65'536;
+
+/* короткие массивы прогоняются много раз, чтобы замер был больше разрешения таймера */
+constexpr size_t kElementsPerRun = size_t{1} << 20;
+
+/* единый интерфейс над self::Array и std::array */
+template <typename T, size_t N>
+void Fill(self::Array<T, N>& arr, const T& value) { arr.Fill(value); }
+template <typename T, size_t N>
+void Fill(std::array<T, N>& arr, const T& value) { arr.fill(value); }
+
+template <typename T, size_t N>
+void Swap(self::Array<T, N>& lhs, self::Array<T, N>& rhs) { lhs.Swap(rhs); }
+template <typename T, size_t N>
+void Swap(std::array<T, N>& lhs, std::array<T, N>& rhs) { lhs.swap(rhs); }
+
+/* большие массивы не помещаются на стек */
+template <typename Arr, typename T>
+std::unique_ptr<Arr> Filled(size_t seed) {
+    auto arr = std::make_unique<Arr>();
+    Fill(*arr, PoolValue<T>(seed));
+    return arr;
+}
+
+template <typename Arr, typename T, size_t N>
+Measurement FillAll(size_t) {
+    Stopwatch sw;
+    auto arr = std::make_unique<Arr>();
+    const size_t runs = std::max<size_t>(1, kElementsPerRun / N);
+    sw.Start();
+    for (size_t i = 0; i < runs; ++i) {
+        Fill(*arr, PoolValue<T>(i));
+        ClobberMemory();
+    }
+    sw.Stop();
+    DoNotOptimize(arr->begin());
+    return {sw.Nanoseconds(), runs * N};
+}
+
+template <typename Arr, typename T, size_t N>
+Measurement Compare(size_t) {
+    Stopwatch sw;
+    /* равные массивы — худший случай, сравнение доходит до конца */
+    auto lhs = Filled<Arr, T>(1);
+    auto rhs = Filled<Arr, T>(1);
+    const size_t runs = std::max<size_t>(1, kElementsPerRun / N);
+    size_t equal = 0;
+    sw.Start();
+    for (size_t i = 0; i < runs; ++i) {
+        equal += *lhs == *rhs;
+        ClobberMemory();
+    }
+    sw.Stop();
+    DoNotOptimize(equal);
+    return {sw.Nanoseconds(), runs * N};
+}
+
+template <typename Arr, typename T, size_t N>
+Measurement SwapAll(size_t) {
+    Stopwatch sw;
+    auto lhs = Filled<Arr, T>(1);
+    auto rhs = Filled<Arr, T>(2);
+    const size_t runs = std::max<size_t>(1, kElementsPerRun / N);
+    sw.Start();
+    for (size_t i = 0; i < runs; ++i) {
+        Swap(*lhs, *rhs);
+        ClobberMemory();
+    }
+    sw.Stop();
+    DoNotOptimize(lhs->begin());
+    return {sw.Nanoseconds(), runs * N};
+}
+
+template <typename T, size_t N>
+void RegisterSize(Registry& registry) {
+    using Self = self::Array<T, N>;
+    using Std = std::array<T, N>;
+    registry.Add({"array", "self", "fill", TypeName<T>(), 0, &FillAll<Self, T, N>, N});
+    registry.Add({"array", "std", "fill", TypeName<T>(), 0, &FillAll<Std, T, N>, N});
+    registry.Add({"array", "self", "compare", TypeName<T>(), 0, &Compare<Self, T, N>, N});
+    registry.Add({"array", "std", "compare", TypeName<T>(), 0, &Compare<Std, T, N>, N});
+    registry.Add({"array", "self", "swap", TypeName<T>(), 0, &SwapAll<Self, T, N>, N});
+    registry.Add({"array", "std", "swap", TypeName<T>(), 0, &SwapAll<Std, T, N>, N});
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    RegisterSize<T, kSmall>(registry);
+    RegisterSize<T, kMedium>(registry);
+    RegisterSize<T, kLarge>(registry);
+}
+
+} // namespace
+
+void RegisterArrayBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
@@ -0,0 +1,152 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+    Минимальный харнесс для сравнения контейнеров self:: с их аналогами из std::.
+    Каждый бенчмарк сам готовит данные и замеряет только интересующую операцию,
+    харнесс повторяет его до набора min_time_ms и выводит результаты в JSON
+*/
+namespace bench {
+
+/* "большой" POD: 128 байт, копируется memcpy, но не влезает в регистры */
+struct LargePod {
+    uint64_t words[16];
+
+    friend bool operator==(const LargePod&, const LargePod&) = default;
+};
+
+template <typename T>
+T MakeValue(size_t i);
+
+template <>
+inline int MakeValue<int>(size_t i) {
+    return static_cast<int>(i * 2654435761u);
+}
+
+template <>
+inline std::string MakeValue<std::string>(size_t i) {
+    /* короткие строки: укладываются в SSO и не зависят от аллокатора */
+    return "key_" + std::to_string(i % 100'000'000);
+}
+
+template <>
+inline LargePod MakeValue<LargePod>(size_t i) {
+    LargePod pod{};
+    for (size_t w = 0; w < 16; ++w) {
+        pod.words[w] = i + w;
+    }
+    return pod;
+}
+
+template <typename T>
+const char* TypeName();
+
+template <>
+inline const char* TypeName<int>() { return "int"; }
+template <>
+inline const char* TypeName<std::string>() { return "string"; }
+template <>
+inline const char* TypeName<LargePod>() { return "large_pod"; }
+
+/* свертка значения в число, чтобы обход контейнера нельзя было выкинуть */
+inline size_t Touch(int value) { return static_cast<size_t>(value); }
+inline size_t Touch(const std::string& value) { return value.size(); }
+inline size_t Touch(const LargePod& value) { return value.words[0]; }
+
+/* пул заранее сгенерированных значений, чтобы в замер не попадала их генерация */
+inline constexpr size_t kPoolSize = 4096;
+
+template <typename T>
+const std::vector<T>& Pool() {
+    static const std::vector<T> pool = [] {
+        std::vector<T> values;
+        values.reserve(kPoolSize);
+        for (size_t i = 0; i < kPoolSize; ++i) {
+            values.push_back(MakeValue<T>(i));
+        }
+        return values;
+    }();
+    return pool;
+}
+
+template <typename T>
+const T& PoolValue(size_t i) {
+    return Pool<T>()[i & (kPoolSize - 1)];
+}
+
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+class Stopwatch {
+public:
+    void Start() {
+        start_ = Clock::now();
+    }
+    void Stop() {
+        elapsed_ += Clock::now() - start_;
+    }
+    int64_t Nanoseconds() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed_).count();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start_;
+    Clock::duration elapsed_{};
+};
+
+/* результат одного прогона: сколько длился замер и сколько операций в него вошло */
+struct Measurement {
+    int64_t nanoseconds = 0;
+    size_t operations = 0;
+};
+
+using RunFn = Measurement (*)(size_t size);
+
+struct Case {
+    std::string container;
+    std::string impl;       // "self" или "std"
+    std::string operation;
+    std::string type;
+    /* сколько памяти нужно бенчмарку на один элемент, 0 — не зависит от размера */
+    size_t bytes_per_element = 0;
+    RunFn run = nullptr;
+    /* ненулевое значение — размер фиксирован на этапе компиляции (Array) */
+    size_t fixed_size = 0;
+};
+
+class Registry {
+public:
+    void Add(Case c) {
+        cases_.push_back(std::move(c));
+    }
+    const std::vector<Case>& Cases() const {
+        return cases_;
+    }
+
+private:
+    std::vector<Case> cases_;
+};
+
+void RegisterVectorBenchmarks(Registry& registry);
+void RegisterListBenchmarks(Registry& registry);
+void RegisterOptionalBenchmarks(Registry& registry);
+void RegisterArrayBenchmarks(Registry& registry);
+void RegisterFlatHashMapBenchmarks(Registry& registry);
+void RegisterFlatMapBenchmarks(Registry& registry);
+void RegisterDequeBenchmarks(Registry& registry);
+void RegisterBitVectorBenchmarks(Registry& registry);
+void RegisterSnapshotVectorBenchmarks(Registry& registry);
+void RegisterRangesBenchmarks(Registry& registry);
+
+} // bench
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+
+/*
+    Запуск: container_bench [--filter=STR] [--min-size=N] [--max-size=N]
+                            [--max-bytes=N] [--min-time-ms=N] [--out=FILE]
+    Результаты печатаются в stdout (или в --out) в формате JSON,
+    прогресс — в stderr
+*/
+namespace {
+
+/* флаги сборки, от которых зависят цифры: без них прогоны с разных машин не сравнить */
+#ifdef STL_CONTAINERS_BENCH_NATIVE
+constexpr bool kNativeBuild = true;
+#else
+constexpr bool kNativeBuild = false;
+#endif
+#ifdef __POPCNT__
+constexpr bool kHasPopcnt = true;
+#else
+constexpr bool kHasPopcnt = false;
+#endif
+#ifdef __BMI2__
+constexpr bool kHasBmi2 = true;
+#else
+constexpr bool kHasBmi2 = false;
+#endif
+#ifdef __AVX2__
+constexpr bool kHasAvx2 = true;
+#else
+constexpr bool kHasAvx2 = false;
+#endif
+
+struct Options {
+    std::string filter;
+    size_t min_size = 1'000;
+    size_t max_size = 100'000'000;
+    /* бюджет памяти на один прогон: large_pod x 100M не влезет в обычную машину */
+    size_t max_bytes = size_t{4} << 30;
+    double min_time_ms = 100.0;
+    size_t max_repetitions = 1'000;
+    std::string out;
+};
+
+struct Result {
+    const bench::Case* c = nullptr;
+    size_t size = 0;
+    size_t repetitions = 0;
+    double min_ns_per_op = 0.0;
+    double mean_ns_per_op = 0.0;
+};
+
+bool ParseFlag(std::string_view arg, std::string_view name, std::string_view& value) {
+    if (arg.substr(0, name.size()) != name || arg.size() <= name.size()
+            || arg[name.size()] != '=') {
+        return false;
+    }
+    value = arg.substr(name.size() + 1);
+    return true;
+}
+
+size_t ParseSize(std::string_view value) {
+    return static_cast<size_t>(std::stoull(std::string(value)));
+}
+
+Options ParseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        std::string_view value;
+        if (ParseFlag(arg, "--filter", value)) {
+            options.filter = value;
+        } else if (ParseFlag(arg, "--min-size", value)) {
+            options.min_size = std::max<size_t>(1, ParseSize(value));
+        } else if (ParseFlag(arg, "--max-size", value)) {
+            options.max_size = ParseSize(value);
+        } else if (ParseFlag(arg, "--max-bytes", value)) {
+            options.max_bytes = ParseSize(value);
+        } else if (ParseFlag(arg, "--min-time-ms", value)) {
+            options.min_time_ms = std::stod(std::string(value));
+        } else if (ParseFlag(arg, "--max-repetitions", value)) {
+            options.max_repetitions = std::max<size_t>(1, ParseSize(value));
+        } else if (ParseFlag(arg, "--out", value)) {
+            options.out = value;
+        } else {
+            std::cerr << "unknown argument: " << arg << '\n';
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    return options;
+}
+
+std::string CaseName(const bench::Case& c) {
+    return c.container + "/" + c.impl + "/" + c.operation + "/" + c.type;
+}
+
+Result RunCase(const bench::Case& c, size_t size, const Options& options) {
+    Result result;
+    result.c = &c;
+    result.size = size;
+    result.min_ns_per_op = std::numeric_limits<double>::max();
+
+    double total_ns = 0.0;
+    double total_ns_per_op = 0.0;
+    while (result.repetitions < options.max_repetitions
+            && (result.repetitions == 0 || total_ns < options.min_time_ms * 1e6)) {
+        bench::Measurement m = c.run(size);
+        double ns_per_op = static_cast<double>(m.nanoseconds)
+                           / static_cast<double>(std::max<size_t>(1, m.operations));
+        result.min_ns_per_op = std::min(result.min_ns_per_op, ns_per_op);
+        total_ns_per_op += ns_per_op;
+        total_ns += static_cast<double>(m.nanoseconds);
+        ++result.repetitions;
+    }
+    result.mean_ns_per_op = total_ns_per_op / static_cast<double>(result.repetitions);
+    return result;
+}
+
+std::string EscapeJson(const std::string& s) {
+    std::string escaped;
+    for (char ch : s) {
+        switch (ch) {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                escaped += buf;
+            } else {
+                escaped += ch;
+            }
+        }
+    }
+    return escaped;
+}
+
+void WriteJson(std::ostream& out, const Options& options, const std::vector<Result>& results) {
+    out << "{\n  \"context\": {\n";
+    out << "    \"compiler\": \"" << EscapeJson(__VERSION__) << "\",\n";
+#ifdef NDEBUG
+    out << "    \"assertions\": false,\n";
+#else
+    out << "    \"assertions\": true,\n";
+#endif
+    out << "    \"native\": " << (kNativeBuild ? "true" : "false") << ",\n";
+    out << "    \"popcnt\": " << (kHasPopcnt ? "true" : "false") << ",\n";
+    out << "    \"bmi2\": " << (kHasBmi2 ? "true" : "false") << ",\n";
+    out << "    \"avx2\": " << (kHasAvx2 ? "true" : "false") << ",\n";
+    out << "    \"min_time_ms\": " << options.min_time_ms << ",\n";
+    out << "    \"max_bytes\": " << options.max_bytes << "\n";
+    out << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << EscapeJson(CaseName(*r.c) + "/" + std::to_string(r.size))
+            << "\", \"container\": \"" << EscapeJson(r.c->container)
+            << "\", \"impl\": \"" << EscapeJson(r.c->impl)
+            << "\", \"operation\": \"" << EscapeJson(r.c->operation)
+            << "\", \"type\": \"" << EscapeJson(r.c->type)
+            << "\", \"size\": " << r.size
+            << ", \"repetitions\": " << r.repetitions
+            << ", \"min_ns_per_op\": " << r.min_ns_per_op
+            << ", \"mean_ns_per_op\": " << r.mean_ns_per_op << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = ParseOptions(argc, argv);
+
+    bench::Registry registry;
+    bench::RegisterVectorBenchmarks(registry);
+    bench::RegisterListBenchmarks(registry);
+    bench::RegisterOptionalBenchmarks(registry);
+    bench::RegisterArrayBenchmarks(registry);
+    bench::RegisterFlatHashMapBenchmarks(registry);
+    bench::RegisterFlatMapBenchmarks(registry);
+    bench::RegisterDequeBenchmarks(registry);
+    bench::RegisterBitVectorBenchmarks(registry);
+    bench::RegisterSnapshotVectorBenchmarks(registry);
+    bench::RegisterRangesBenchmarks(registry);
+
+    std::vector<Result> results;
+    for (const bench::Case& c : registry.Cases()) {
+        std::string name = CaseName(c);
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        if (c.fixed_size != 0) {
+            std::cerr << name << "/" << c.fixed_size << '\n';
+            results.push_back(RunCase(c, c.fixed_size, options));
+            continue;
+        }
+        for (size_t size = options.min_size; size <= options.max_size; size *= 10) {
+            if (c.bytes_per_element != 0 && size > options.max_bytes / c.bytes_per_element) {
+                std::cerr << name << "/" << size << ": skipped, exceeds --max-bytes\n";
+                break;
+            }
+            std::cerr << name << "/" << size << '\n';
+            results.push_back(RunCase(c, size, options));
+        }
+    }
+
+    if (options.out.empty()) {
+        WriteJson(std::cout, options, results);
+    } else {
+        std::ofstream file(options.out);
+        if (!file) {
+            std::cerr << "cannot open " << options.out << '\n';
+            return EXIT_FAILURE;
+        }
+        WriteJson(file, options, results);
+    }
+    return EXIT_SUCCESS;
+}
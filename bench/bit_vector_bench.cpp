@@ -0,0 +1,120 @@
+#include "bench.h"
+
+#include "bit_vector/bit_vector.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace bench {
+namespace {
+
+/* около трети битов выставлены, без регулярного узора */
+bool Bit(size_t i) {
+    return ((i * 2654435761u) >> 7) % 3 == 0;
+}
+
+template <typename Bits>
+Bits Filled(size_t n, size_t seed) {
+    Bits bits;
+    for (size_t i = 0; i < n; ++i) {
+        if constexpr (std::is_same_v<Bits, self::BitVector>) {
+            bits.PushBack(Bit(i + seed));
+        } else {
+            bits.push_back(Bit(i + seed));
+        }
+    }
+    return bits;
+}
+
+template <typename Bits>
+Measurement PushBack(size_t n) {
+    Stopwatch sw;
+    Bits bits;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        if constexpr (std::is_same_v<Bits, self::BitVector>) {
+            bits.PushBack(Bit(i));
+        } else {
+            bits.push_back(Bit(i));
+        }
+    }
+    sw.Stop();
+    DoNotOptimize(bits);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Bits>
+Measurement Count(size_t n) {
+    Stopwatch sw;
+    const Bits bits = Filled<Bits>(n, 0);
+    size_t count = 0;
+    sw.Start();
+    if constexpr (std::is_same_v<Bits, self::BitVector>) {
+        count = bits.Count();
+    } else {
+        count = static_cast<size_t>(std::count(bits.begin(), bits.end(), true));
+    }
+    sw.Stop();
+    DoNotOptimize(count);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Bits>
+Measurement AndAssign(size_t n) {
+    Stopwatch sw;
+    Bits lhs = Filled<Bits>(n, 0);
+    const Bits rhs = Filled<Bits>(n, 1);
+    sw.Start();
+    if constexpr (std::is_same_v<Bits, self::BitVector>) {
+        lhs &= rhs;
+    } else {
+        /* у std::vector<bool> нет пословных операций */
+        for (size_t i = 0; i < n; ++i) {
+            lhs[i] = lhs[i] && rhs[i];
+        }
+    }
+    sw.Stop();
+    DoNotOptimize(lhs);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Bits>
+Measurement IterateSetBits(size_t n) {
+    Stopwatch sw;
+    const Bits bits = Filled<Bits>(n, 0);
+    size_t sum = 0;
+    sw.Start();
+    if constexpr (std::is_same_v<Bits, self::BitVector>) {
+        for (size_t pos = bits.FindFirst(); pos != self::BitVector::npos; pos = bits.FindNext(pos)) {
+            sum += pos;
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            if (bits[i]) {
+                sum += i;
+            }
+        }
+    }
+    sw.Stop();
+    DoNotOptimize(sum);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Bits>
+void RegisterImpl(Registry& registry, const char* impl) {
+    /* два вектора по биту на элемент: байта хватает с запасом */
+    const size_t bytes = 1;
+    registry.Add({"bit_vector", impl, "push_back", "bool", bytes, &PushBack<Bits>});
+    registry.Add({"bit_vector", impl, "count", "bool", bytes, &Count<Bits>});
+    registry.Add({"bit_vector", impl, "and_assign", "bool", bytes, &AndAssign<Bits>});
+    registry.Add({"bit_vector", impl, "iterate_set_bits", "bool", bytes, &IterateSetBits<Bits>});
+}
+
+} // namespace
+
+void RegisterBitVectorBenchmarks(Registry& registry) {
+    RegisterImpl<self::BitVector>(registry, "self");
+    RegisterImpl<std::vector<bool>>(registry, "std");
+}
+
+} // bench
@@ -0,0 +1,117 @@
+#include "bench.h"
+
+#include "deque/deque.h"
+
+#include <deque>
+
+namespace bench {
+namespace {
+
+/* размер скользящего окна в бенчмарке sliding_window */
+constexpr size_t kWindow = 1'024;
+
+/* единый интерфейс над self::Deque и std::deque */
+template <typename T>
+void PushBack(self::Deque<T>& deque, const T& value) { deque.PushBack(value); }
+template <typename T>
+void PushBack(std::deque<T>& deque, const T& value) { deque.push_back(value); }
+
+template <typename T>
+void PushFront(self::Deque<T>& deque, const T& value) { deque.PushFront(value); }
+template <typename T>
+void PushFront(std::deque<T>& deque, const T& value) { deque.push_front(value); }
+
+template <typename T>
+void PopFront(self::Deque<T>& deque) { deque.PopFront(); }
+template <typename T>
+void PopFront(std::deque<T>& deque) { deque.pop_front(); }
+
+template <typename Deq, typename T>
+Measurement PushBackAll(size_t n) {
+    Stopwatch sw;
+    Deq deque;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        PushBack(deque, PoolValue<T>(i));
+    }
+    sw.Stop();
+    DoNotOptimize(deque);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Deq, typename T>
+Measurement PushFrontAll(size_t n) {
+    Stopwatch sw;
+    Deq deque;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        PushFront(deque, PoolValue<T>(i));
+    }
+    sw.Stop();
+    DoNotOptimize(deque);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Deq, typename T>
+Measurement SlidingWindow(size_t n) {
+    Stopwatch sw;
+    Deq deque;
+    for (size_t i = 0; i < kWindow; ++i) {
+        PushBack(deque, PoolValue<T>(i));
+    }
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        PushBack(deque, PoolValue<T>(i));
+        PopFront(deque);
+    }
+    sw.Stop();
+    DoNotOptimize(deque);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Deq, typename T>
+Measurement RandomAccess(size_t n) {
+    Stopwatch sw;
+    Deq deque;
+    for (size_t i = 0; i < n; ++i) {
+        PushBack(deque, PoolValue<T>(i));
+    }
+    size_t sum = 0;
+    size_t index = 0;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        /* 7919 — простое: при n, не кратном ему, обход посещает все элементы вразброс */
+        index += 7919;
+        index = index >= n ? index % n : index;
+        sum += Touch(deque[index]);
+    }
+    sw.Stop();
+    DoNotOptimize(sum);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Deq, typename T>
+void RegisterImpl(Registry& registry, const char* impl) {
+    const size_t bytes = sizeof(T) + sizeof(T) / 8;
+    registry.Add({"deque", impl, "push_back", TypeName<T>(), bytes, &PushBackAll<Deq, T>});
+    registry.Add({"deque", impl, "push_front", TypeName<T>(), bytes, &PushFrontAll<Deq, T>});
+    /* память окна не зависит от n */
+    registry.Add({"deque", impl, "sliding_window", TypeName<T>(), 0, &SlidingWindow<Deq, T>});
+    registry.Add({"deque", impl, "random_access", TypeName<T>(), bytes, &RandomAccess<Deq, T>});
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    RegisterImpl<self::Deque<T>, T>(registry, "self");
+    RegisterImpl<std::deque<T>, T>(registry, "std");
+}
+
+} // namespace
+
+void RegisterDequeBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
@@ -0,0 +1,136 @@
+#include "bench.h"
+
+#include "flat_hash_map/flat_hash_map.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+
+namespace bench {
+namespace {
+
+/* единый интерфейс над self::FlatHashMap и std::unordered_map */
+template <typename K, typename V>
+void Reserve(self::FlatHashMap<K, V>& map, size_t n) { map.Reserve(n); }
+template <typename K, typename V>
+void Reserve(std::unordered_map<K, V>& map, size_t n) { map.reserve(n); }
+
+template <typename K, typename V>
+void Put(self::FlatHashMap<K, V>& map, const K& key, const V& value) { map.TryEmplace(key, value); }
+template <typename K, typename V>
+void Put(std::unordered_map<K, V>& map, const K& key, const V& value) { map.try_emplace(key, value); }
+
+template <typename K, typename V>
+bool Has(const self::FlatHashMap<K, V>& map, const K& key) { return map.Contains(key); }
+template <typename K, typename V>
+bool Has(const std::unordered_map<K, V>& map, const K& key) { return map.count(key) != 0; }
+
+template <typename K, typename V>
+size_t Remove(self::FlatHashMap<K, V>& map, const K& key) { return map.Erase(key); }
+template <typename K, typename V>
+size_t Remove(std::unordered_map<K, V>& map, const K& key) { return map.erase(key); }
+
+/* ключи i и i + n не пересекаются: вторые используются для промахов */
+template <typename K>
+K Key(size_t i) {
+    if constexpr (std::is_same_v<K, int>) {
+        return static_cast<int>(i);
+    } else {
+        return "key_" + std::to_string(i);
+    }
+}
+
+template <typename Map, typename K>
+Map Filled(size_t n) {
+    Map map;
+    Reserve(map, n);
+    for (size_t i = 0; i < n; ++i) {
+        Put(map, Key<K>(i), static_cast<int>(i));
+    }
+    return map;
+}
+
+/*
+    Ключи генерируются заранее, чтобы в замер не попало форматирование строк,
+    и перемешиваются: при последовательном порядке std::hash<int> (тождественный)
+    дал бы std::unordered_map идеально последовательный доступ к памяти
+*/
+template <typename K>
+std::vector<K> Keys(size_t first, size_t n) {
+    std::vector<K> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back(Key<K>(first + i));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(n));
+    return keys;
+}
+
+template <typename Map, typename K>
+Measurement Insert(size_t n) {
+    Stopwatch sw;
+    const std::vector<K> keys = Keys<K>(0, n);
+    Map map;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        Put(map, keys[i], static_cast<int>(i));
+    }
+    sw.Stop();
+    DoNotOptimize(map);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Map, typename K, bool kHit>
+Measurement Find(size_t n) {
+    Stopwatch sw;
+    const Map map = Filled<Map, K>(n);
+    const std::vector<K> keys = Keys<K>(kHit ? 0 : n, n);
+    size_t found = 0;
+    sw.Start();
+    for (const K& key : keys) {
+        found += Has(map, key);
+    }
+    sw.Stop();
+    DoNotOptimize(found);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Map, typename K>
+Measurement Erase(size_t n) {
+    Stopwatch sw;
+    Map map = Filled<Map, K>(n);
+    const std::vector<K> keys = Keys<K>(0, n);
+    size_t erased = 0;
+    sw.Start();
+    for (const K& key : keys) {
+        erased += Remove(map, key);
+    }
+    sw.Stop();
+    DoNotOptimize(erased);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Map, typename K>
+void RegisterImpl(Registry& registry, const char* impl, const char* type) {
+    /* ключи для замера, пара в таблице с учетом загрузки и узлы std::unordered_map */
+    const size_t bytes = 3 * (sizeof(K) + sizeof(int)) + 4 * sizeof(void*);
+    registry.Add({"hash_map", impl, "insert", type, bytes, &Insert<Map, K>});
+    registry.Add({"hash_map", impl, "find_hit", type, bytes, &Find<Map, K, true>});
+    registry.Add({"hash_map", impl, "find_miss", type, bytes, &Find<Map, K, false>});
+    registry.Add({"hash_map", impl, "erase", type, bytes, &Erase<Map, K>});
+}
+
+template <typename K>
+void RegisterType(Registry& registry) {
+    RegisterImpl<self::FlatHashMap<K, int>, K>(registry, "self", TypeName<K>());
+    RegisterImpl<std::unordered_map<K, int>, K>(registry, "std", TypeName<K>());
+}
+
+} // namespace
+
+void RegisterFlatHashMapBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+}
+
+} // bench
@@ -0,0 +1,115 @@
+#include "bench.h"
+
+#include "flat_map/flat_map.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+namespace bench {
+namespace {
+
+/* ключи перемешаны, иначе вставка в std::map всегда шла бы в крайний правый узел */
+template <typename K>
+std::vector<K> ShuffledKeys(size_t n) {
+    std::vector<K> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back(MakeValue<K>(i));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(n));
+    return keys;
+}
+
+template <typename K>
+Measurement SelfInsertMany(size_t n) {
+    Stopwatch sw;
+    std::vector<std::pair<K, int>> items;
+    items.reserve(n);
+    for (const K& key : ShuffledKeys<K>(n)) {
+        items.emplace_back(key, 0);
+    }
+    self::FlatMap<K, int> map;
+    sw.Start();
+    map.InsertMany(items.begin(), items.end());
+    sw.Stop();
+    DoNotOptimize(map);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename K>
+Measurement StdInsert(size_t n) {
+    Stopwatch sw;
+    const std::vector<K> keys = ShuffledKeys<K>(n);
+    std::map<K, int> map;
+    sw.Start();
+    for (const K& key : keys) {
+        map.try_emplace(key, 0);
+    }
+    sw.Stop();
+    DoNotOptimize(map);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename K, bool kFrozen>
+Measurement SelfFind(size_t n) {
+    Stopwatch sw;
+    const std::vector<K> keys = ShuffledKeys<K>(n);
+    std::vector<std::pair<K, int>> items;
+    items.reserve(n);
+    for (const K& key : keys) {
+        items.emplace_back(key, 0);
+    }
+    self::FlatMap<K, int> map;
+    map.InsertMany(items.begin(), items.end());
+    if constexpr (kFrozen) {
+        map.Freeze();
+    }
+    size_t found = 0;
+    sw.Start();
+    for (const K& key : keys) {
+        found += map.Contains(key);
+    }
+    sw.Stop();
+    DoNotOptimize(found);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename K>
+Measurement StdFind(size_t n) {
+    Stopwatch sw;
+    const std::vector<K> keys = ShuffledKeys<K>(n);
+    std::map<K, int> map;
+    for (const K& key : keys) {
+        map.try_emplace(key, 0);
+    }
+    size_t found = 0;
+    sw.Start();
+    for (const K& key : keys) {
+        found += map.count(key);
+    }
+    sw.Stop();
+    DoNotOptimize(found);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename K>
+void RegisterType(Registry& registry) {
+    /* ключи для замера, копия пачки и узлы std::map */
+    const size_t bytes = 3 * (sizeof(K) + sizeof(int)) + 4 * sizeof(void*);
+    const char* type = TypeName<K>();
+    registry.Add({"flat_map", "self", "insert_many", type, bytes, &SelfInsertMany<K>});
+    registry.Add({"flat_map", "std", "insert", type, bytes, &StdInsert<K>});
+    registry.Add({"flat_map", "self", "find_sorted", type, bytes, &SelfFind<K, false>});
+    registry.Add({"flat_map", "self", "find_frozen", type, bytes, &SelfFind<K, true>});
+    registry.Add({"flat_map", "std", "find", type, bytes, &StdFind<K>});
+}
+
+} // namespace
+
+void RegisterFlatMapBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+}
+
+} // bench
@@ -0,0 +1,91 @@
+#include "bench.h"
+
+#include "list/list.h"
+
+#include <forward_list>
+
+namespace bench {
+namespace {
+
+/* единый интерфейс над self::SingleLinkedList и std::forward_list */
+template <typename T>
+void PushFront(self::SingleLinkedList<T>& list, const T& value) { list.PushFront(value); }
+template <typename T>
+void PushFront(std::forward_list<T>& list, const T& value) { list.push_front(value); }
+
+template <typename T>
+void Clear(self::SingleLinkedList<T>& list) { list.Clear(); }
+template <typename T>
+void Clear(std::forward_list<T>& list) { list.clear(); }
+
+template <typename List, typename T>
+List Filled(size_t n) {
+    List list;
+    for (size_t i = 0; i < n; ++i) {
+        PushFront(list, PoolValue<T>(i));
+    }
+    return list;
+}
+
+template <typename List, typename T>
+Measurement Push(size_t n) {
+    Stopwatch sw;
+    List list;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        PushFront(list, PoolValue<T>(i));
+    }
+    sw.Stop();
+    DoNotOptimize(list.begin());
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename List, typename T>
+Measurement Traverse(size_t n) {
+    Stopwatch sw;
+    const List list = Filled<List, T>(n);
+    size_t sum = 0;
+    sw.Start();
+    for (const T& value : list) {
+        sum += Touch(value);
+    }
+    sw.Stop();
+    DoNotOptimize(sum);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename List, typename T>
+Measurement ClearAll(size_t n) {
+    Stopwatch sw;
+    List list = Filled<List, T>(n);
+    sw.Start();
+    Clear(list);
+    sw.Stop();
+    DoNotOptimize(list.begin());
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename List, typename T>
+void RegisterImpl(Registry& registry, const char* impl) {
+    /* значение, указатель на следующий узел и заголовок блока malloc */
+    const size_t bytes = sizeof(T) + 2 * sizeof(void*);
+    registry.Add({"list", impl, "push_front", TypeName<T>(), bytes, &Push<List, T>});
+    registry.Add({"list", impl, "traverse", TypeName<T>(), bytes, &Traverse<List, T>});
+    registry.Add({"list", impl, "clear", TypeName<T>(), bytes, &ClearAll<List, T>});
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    RegisterImpl<self::SingleLinkedList<T>, T>(registry, "self");
+    RegisterImpl<std::forward_list<T>, T>(registry, "std");
+}
+
+} // namespace
+
+void RegisterListBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
@@ -0,0 +1,94 @@
+#include "bench.h"
+
+#include "optional/optional.h"
+
+#include <optional>
+
+namespace bench {
+namespace {
+
+/* единый интерфейс над self::Optional и std::optional */
+template <typename T>
+void Emplace(self::Optional<T>& opt, const T& value) { opt.Emplace(value); }
+template <typename T>
+void Emplace(std::optional<T>& opt, const T& value) { opt.emplace(value); }
+
+template <typename T>
+void Reset(self::Optional<T>& opt) { opt.Reset(); }
+template <typename T>
+void Reset(std::optional<T>& opt) { opt.reset(); }
+
+template <typename T>
+const T& Value(const self::Optional<T>& opt) { return opt.Value(); }
+template <typename T>
+const T& Value(const std::optional<T>& opt) { return opt.value(); }
+
+template <typename Opt, typename T>
+Measurement EmplaceReset(size_t n) {
+    Stopwatch sw;
+    Opt opt;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        Emplace(opt, PoolValue<T>(i));
+        DoNotOptimize(opt);
+        Reset(opt);
+    }
+    sw.Stop();
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Opt, typename T>
+Measurement CopyAssign(size_t n) {
+    Stopwatch sw;
+    /* чередуем пустой и заполненный источник, чтобы пройти по всем веткам */
+    Opt sources[2];
+    Emplace(sources[1], PoolValue<T>(1));
+    Opt target;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        target = sources[(i >> 1) & 1];
+        DoNotOptimize(target);
+    }
+    sw.Stop();
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Opt, typename T>
+Measurement ValueAccess(size_t n) {
+    Stopwatch sw;
+    Opt opt;
+    Emplace(opt, PoolValue<T>(0));
+    size_t sum = 0;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        sum += Touch(Value(opt));
+        ClobberMemory();
+    }
+    sw.Stop();
+    DoNotOptimize(sum);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Opt, typename T>
+void RegisterImpl(Registry& registry, const char* impl) {
+    /* размер здесь — число операций, память от него не зависит */
+    registry.Add({"optional", impl, "emplace_reset", TypeName<T>(), 0, &EmplaceReset<Opt, T>});
+    registry.Add({"optional", impl, "copy_assign", TypeName<T>(), 0, &CopyAssign<Opt, T>});
+    registry.Add({"optional", impl, "value_access", TypeName<T>(), 0, &ValueAccess<Opt, T>});
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    RegisterImpl<self::Optional<T>, T>(registry, "self");
+    RegisterImpl<std::optional<T>, T>(registry, "std");
+}
+
+} // namespace
+
+void RegisterOptionalBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
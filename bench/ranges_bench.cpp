@@ -0,0 +1,106 @@
+#include "bench.h"
+
+#include "ranges/ranges.h"
+#include "vector/vector.h"
+
+#include <ranges>
+#include <vector>
+
+namespace bench {
+namespace {
+
+/*
+    Один и тот же конвейер filter -> transform -> take тремя способами:
+    ленивые адаптеры self, промежуточный self::Vector на каждом шаге
+    и std::views из C++20
+*/
+/* лямбды, а не указатели на функции: так адаптеры обычно и используют */
+template <typename T>
+constexpr auto Keep = [](const T& value) { return Touch(value) % 3 != 0; };
+
+template <typename T>
+constexpr auto Map = [](const T& value) { return Touch(value) * 2 + 1; };
+
+template <typename T>
+self::Vector<T> Source(size_t n) {
+    self::Vector<T> source;
+    source.Reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        source.PushBack(PoolValue<T>(i));
+    }
+    return source;
+}
+
+template <typename T>
+Measurement Fused(size_t n) {
+    Stopwatch sw;
+    const auto source = Source<T>(n);
+    self::Vector<size_t> out;
+    sw.Start();
+    source | self::Filter(Keep<T>) | self::Transform(Map<T>) | self::Take(n / 2)
+            | self::CollectInto(out);
+    sw.Stop();
+    DoNotOptimize(out);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename T>
+Measurement Staged(size_t n) {
+    Stopwatch sw;
+    const auto source = Source<T>(n);
+    self::Vector<size_t> out;
+    sw.Start();
+    self::Vector<T> filtered;
+    for (const T& value : source) {
+        if (Keep<T>(value)) {
+            filtered.PushBack(value);
+        }
+    }
+    self::Vector<size_t> mapped;
+    mapped.Reserve(filtered.Size());
+    for (const T& value : filtered) {
+        mapped.PushBack(Map<T>(value));
+    }
+    const size_t count = std::min(n / 2, mapped.Size());
+    out.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        out.PushBack(mapped[i]);
+    }
+    sw.Stop();
+    DoNotOptimize(out);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename T>
+Measurement StdViews(size_t n) {
+    Stopwatch sw;
+    const auto source = Source<T>(n);
+    std::vector<size_t> out;
+    sw.Start();
+    for (size_t value : source | std::views::filter(Keep<T>) | std::views::transform(Map<T>)
+                              | std::views::take(n / 2)) {
+        out.push_back(value);
+    }
+    sw.Stop();
+    DoNotOptimize(out);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    /* исходные данные, а у staged еще и копии прошедших фильтр */
+    const size_t bytes = 2 * sizeof(T) + sizeof(size_t);
+    registry.Add({"ranges", "self", "filter_transform_take", TypeName<T>(), bytes, &Fused<T>});
+    registry.Add({"ranges", "staged", "filter_transform_take", TypeName<T>(), bytes, &Staged<T>});
+    registry.Add({"ranges", "std", "filter_transform_take", TypeName<T>(), bytes, &StdViews<T>});
+}
+
+} // namespace
+
+void RegisterRangesBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
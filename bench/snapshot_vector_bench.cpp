@@ -0,0 +1,98 @@
+#include "bench.h"
+
+#include "snapshot_vector/snapshot_vector.h"
+
+#include <memory>
+#include <vector>
+
+namespace bench {
+namespace {
+
+/* сколько публикаций делается за один замер */
+constexpr size_t kPublishes = 64;
+
+/*
+    Для сравнения — обычный способ: неизменяемый std::vector под shared_ptr,
+    каждая публикация копирует его целиком
+*/
+template <typename T>
+class CopyOnPublish {
+public:
+    void PushBack(const T& value) { draft_.push_back(value); }
+    void Set(size_t index, const T& value) { draft_[index] = value; }
+    void Publish() { current_ = std::make_shared<const std::vector<T>>(draft_); }
+    std::shared_ptr<const std::vector<T>> Load() const { return current_; }
+
+private:
+    std::vector<T> draft_;
+    std::shared_ptr<const std::vector<T>> current_;
+};
+
+/* содержимое снимка: у self это сам Snapshot, у std — вектор под shared_ptr */
+template <typename S>
+const S& Items(const S& snapshot) { return snapshot; }
+template <typename S>
+const S& Items(const std::shared_ptr<const S>& snapshot) { return *snapshot; }
+
+template <typename Vec, typename T>
+Measurement SetAndPublish(size_t n) {
+    Stopwatch sw;
+    Vec vector;
+    for (size_t i = 0; i < n; ++i) {
+        vector.PushBack(PoolValue<T>(i));
+    }
+    vector.Publish();
+    sw.Start();
+    for (size_t i = 0; i < kPublishes; ++i) {
+        vector.Set(i * 7919 % n, PoolValue<T>(i));
+        vector.Publish();
+    }
+    sw.Stop();
+    DoNotOptimize(vector);
+    return {sw.Nanoseconds(), kPublishes};
+}
+
+template <typename Vec, typename T>
+Measurement ReadSnapshot(size_t n) {
+    Stopwatch sw;
+    Vec vector;
+    for (size_t i = 0; i < n; ++i) {
+        vector.PushBack(PoolValue<T>(i));
+    }
+    vector.Publish();
+    size_t sum = 0;
+    sw.Start();
+    const auto snapshot = vector.Load();
+    for (const auto& value : Items(snapshot)) {
+        sum += Touch(value);
+    }
+    sw.Stop();
+    DoNotOptimize(sum);
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Vec, typename T>
+void RegisterImpl(Registry& registry, const char* impl) {
+    /* черновик и опубликованная версия */
+    const size_t bytes = 2 * sizeof(T);
+    registry.Add({"snapshot_vector", impl, "set_and_publish", TypeName<T>(), bytes,
+                  &SetAndPublish<Vec, T>});
+    registry.Add({"snapshot_vector", impl, "read_snapshot", TypeName<T>(), bytes,
+                  &ReadSnapshot<Vec, T>});
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    RegisterImpl<self::SnapshotVector<T>, T>(registry, "self");
+    RegisterImpl<CopyOnPublish<T>, T>(registry, "std");
+}
+
+} // namespace
+
+void RegisterSnapshotVectorBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
@@ -0,0 +1,128 @@
+#include "bench.h"
+
+#include "vector/vector.h"
+
+#include <vector>
+
+namespace bench {
+namespace {
+
+/* вставок/удалений в середину за прогон: сдвиг половины вектора на 100M элементах дорог */
+constexpr size_t kInsertEraseOps = 16;
+
+/* единый интерфейс над self::Vector и std::vector */
+template <typename T>
+void Append(self::Vector<T>& vec, const T& value) { vec.PushBack(value); }
+template <typename T>
+void Append(std::vector<T>& vec, const T& value) { vec.push_back(value); }
+
+template <typename T>
+void Reserve(self::Vector<T>& vec, size_t n) { vec.Reserve(n); }
+template <typename T>
+void Reserve(std::vector<T>& vec, size_t n) { vec.reserve(n); }
+
+template <typename T>
+void InsertMiddle(self::Vector<T>& vec, const T& value) {
+    vec.Insert(vec.begin() + vec.Size() / 2, value);
+}
+template <typename T>
+void InsertMiddle(std::vector<T>& vec, const T& value) {
+    vec.insert(vec.begin() + vec.size() / 2, value);
+}
+
+template <typename T>
+void EraseMiddle(self::Vector<T>& vec) { vec.Erase(vec.begin() + vec.Size() / 2); }
+template <typename T>
+void EraseMiddle(std::vector<T>& vec) { vec.erase(vec.begin() + vec.size() / 2); }
+
+template <typename Vec, typename T>
+Vec Filled(size_t n) {
+    Vec vec;
+    Reserve(vec, n);
+    for (size_t i = 0; i < n; ++i) {
+        Append(vec, PoolValue<T>(i));
+    }
+    return vec;
+}
+
+template <typename Vec, typename T>
+Measurement PushBack(size_t n) {
+    Stopwatch sw;
+    Vec vec;
+    sw.Start();
+    for (size_t i = 0; i < n; ++i) {
+        Append(vec, PoolValue<T>(i));
+    }
+    sw.Stop();
+    DoNotOptimize(vec.begin());
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Vec, typename T>
+Measurement ReservePushBack(size_t n) {
+    Stopwatch sw;
+    Vec vec;
+    sw.Start();
+    Reserve(vec, n);
+    for (size_t i = 0; i < n; ++i) {
+        Append(vec, PoolValue<T>(i));
+    }
+    sw.Stop();
+    DoNotOptimize(vec.begin());
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Vec, typename T>
+Measurement InsertErase(size_t n) {
+    Stopwatch sw;
+    Vec vec = Filled<Vec, T>(n);
+    sw.Start();
+    for (size_t i = 0; i < kInsertEraseOps; ++i) {
+        InsertMiddle(vec, PoolValue<T>(i));
+    }
+    for (size_t i = 0; i < kInsertEraseOps; ++i) {
+        EraseMiddle(vec);
+    }
+    sw.Stop();
+    DoNotOptimize(vec.begin());
+    return {sw.Nanoseconds(), 2 * kInsertEraseOps};
+}
+
+template <typename Vec, typename T>
+Measurement Copy(size_t n) {
+    Stopwatch sw;
+    const Vec source = Filled<Vec, T>(n);
+    sw.Start();
+    Vec copy(source);
+    sw.Stop();
+    DoNotOptimize(copy.begin());
+    return {sw.Nanoseconds(), n};
+}
+
+template <typename Vec, typename T>
+void RegisterImpl(Registry& registry, const char* impl) {
+    /* с запасом на удвоение емкости */
+    const size_t bytes = 2 * sizeof(T);
+    registry.Add({"vector", impl, "push_back", TypeName<T>(), bytes, &PushBack<Vec, T>});
+    registry.Add({"vector", impl, "reserve_push_back", TypeName<T>(), bytes,
+                  &ReservePushBack<Vec, T>});
+    registry.Add({"vector", impl, "insert_erase_middle", TypeName<T>(), bytes,
+                  &InsertErase<Vec, T>});
+    registry.Add({"vector", impl, "copy", TypeName<T>(), bytes, &Copy<Vec, T>});
+}
+
+template <typename T>
+void RegisterType(Registry& registry) {
+    RegisterImpl<self::Vector<T>, T>(registry, "self");
+    RegisterImpl<std::vector<T>, T>(registry, "std");
+}
+
+} // namespace
+
+void RegisterVectorBenchmarks(Registry& registry) {
+    RegisterType<int>(registry);
+    RegisterType<std::string>(registry);
+    RegisterType<LargePod>(registry);
+}
+
+} // bench
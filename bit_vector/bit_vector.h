@@ -0,0 +1,532 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+#include "vector/vector.h"
+
+namespace self {
+
+/*
+    Упакованный битовый вектор: 64 флага в одном машинном слове вместо байта на флаг
+    у self::Vector<bool>. Интерфейс повторяет Vector (PushBack, Resize, operator[],
+    итераторы), а operator[] возвращает прокси-ссылку на бит.
+    Массовые операции (&=, |=, ^=, Flip, Count, FindNext) идут по словам простыми
+    циклами, которые компилятор векторизует; Count использует std::popcount,
+    который становится инструкцией popcnt при сборке с -mpopcnt или -march=native
+    (CMake-опция STL_CONTAINERS_NATIVE; container_bench собирается так всегда).
+    Биты последнего слова за пределами Size() всегда нулевые
+*/
+class BitVector {
+    using Word = uint64_t;
+    static constexpr size_t kWordBits = 64;
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /* прокси-ссылка на один бит */
+    class Reference {
+        friend class BitVector;
+
+        Reference(Word* word, Word mask) noexcept
+            : word_(word)
+            , mask_(mask) {}
+
+    public:
+        Reference(const Reference&) = default;
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+        Reference& operator=(bool value) noexcept {
+            if (value) {
+                *word_ |= mask_;
+            } else {
+                *word_ &= ~mask_;
+            }
+            return *this;
+        }
+        /* присваивание копирует значение бита, а не саму ссылку */
+        Reference& operator=(const Reference& rhs) noexcept {
+            return *this = static_cast<bool>(rhs);
+        }
+        void Flip() noexcept {
+            *word_ ^= mask_;
+        }
+
+    private:
+        Word* word_;
+        Word mask_;
+    };
+
+private:
+    template <bool IsConst>
+    class BasicIterator {
+        friend class BitVector;
+        template <bool> friend class BasicIterator;
+
+        using WordPtr = std::conditional_t<IsConst, const Word*, Word*>;
+
+        BasicIterator(WordPtr words, size_t index) noexcept
+            : words_(words)
+            , index_(index) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::conditional_t<IsConst, bool, Reference>;
+
+        BasicIterator() = default;
+
+        /* неконстантный итератор приводится к константному */
+        BasicIterator(const BasicIterator<false>& other) noexcept
+            : words_(other.words_)
+            , index_(other.index_) {}
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] reference operator*() const noexcept {
+            if constexpr (IsConst) {
+                return (words_[index_ / kWordBits] >> (index_ % kWordBits)) & 1;
+            } else {
+                return Reference(words_ + index_ / kWordBits, Word{1} << (index_ % kWordBits));
+            }
+        }
+        [[nodiscard]] reference operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        BasicIterator operator++(int) noexcept {
+            auto copy(*this);
+            ++index_;
+            return copy;
+        }
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        BasicIterator operator--(int) noexcept {
+            auto copy(*this);
+            --index_;
+            return copy;
+        }
+        BasicIterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+        BasicIterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+        [[nodiscard]] friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        [[nodiscard]] friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+            return it += n;
+        }
+        [[nodiscard]] friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        [[nodiscard]] friend difference_type operator-(const BasicIterator& lhs,
+                                                       const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator& rhs) const noexcept {
+            return index_ == rhs.index_;
+        }
+        [[nodiscard]] auto operator<=>(const BasicIterator& rhs) const noexcept {
+            return index_ <=> rhs.index_;
+        }
+
+    private:
+        WordPtr words_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    BitVector() = default;
+
+    explicit BitVector(size_t size, bool value = false) {
+        Resize(size, value);
+    }
+
+    BitVector(std::initializer_list<bool> bits) {
+        Reserve(bits.size());
+        for (bool bit : bits) {
+            PushBack(bit);
+        }
+    }
+
+    BitVector(const BitVector& other) = default;
+
+    BitVector(BitVector&& other) noexcept {
+        Swap(other);
+    }
+
+    BitVector& operator=(const BitVector& rhs) = default;
+
+    BitVector& operator=(BitVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    iterator begin() noexcept {
+        return iterator(words_.begin(), 0);
+    }
+    iterator end() noexcept {
+        return iterator(words_.begin(), size_);
+    }
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_iterator(words_.begin(), 0);
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_iterator(words_.begin(), size_);
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+    /* емкость в битах */
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return words_.Capacity() * kWordBits;
+    }
+
+    /* слова хранилища, младший бит слова i — элемент 64 * i */
+    [[nodiscard]] const Word* Words() const noexcept {
+        return words_.begin();
+    }
+    [[nodiscard]] size_t WordCount() const noexcept {
+        return words_.Size();
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Reference(&words_[index / kWordBits], Mask(index));
+    }
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / kWordBits] & Mask(index)) != 0;
+    }
+
+    bool At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("BitVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    void Set(size_t index, bool value = true) noexcept {
+        (*this)[index] = value;
+    }
+    void Flip(size_t index) noexcept {
+        (*this)[index].Flip();
+    }
+
+    void Reset() noexcept {
+        words_.Reset();
+        size_ = 0;
+    }
+
+    void Swap(BitVector& other) noexcept {
+        words_.Swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    void Reserve(size_t capacity) {
+        words_.Reserve(WordsFor(capacity));
+    }
+
+    void Resize(size_t new_size, bool value = false) {
+        const size_t old_size = size_;
+        /* новые слова Vector::Resize заполняет нулями */
+        words_.Resize(WordsFor(new_size));
+        size_ = new_size;
+        if (new_size > old_size) {
+            if (value) {
+                SetRange(old_size, new_size);
+            }
+        } else {
+            ClearTail();
+        }
+    }
+
+    void PushBack(bool value) {
+        if (size_ % kWordBits == 0) {
+            words_.PushBack(Word{0});
+        }
+        if (value) {
+            words_[size_ / kWordBits] |= Mask(size_);
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        words_[size_ / kWordBits] &= ~Mask(size_);
+        if (size_ % kWordBits == 0) {
+            words_.PopBack();
+        }
+    }
+
+    /* число единичных битов */
+    [[nodiscard]] size_t Count() const noexcept {
+        size_t count = 0;
+        for (Word word : words_) {
+            count += static_cast<size_t>(std::popcount(word));
+        }
+        return count;
+    }
+    [[nodiscard]] bool Any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](Word word) { return word != 0; });
+    }
+    [[nodiscard]] bool None() const noexcept {
+        return !Any();
+    }
+    [[nodiscard]] bool All() const noexcept {
+        return Count() == size_;
+    }
+
+    /* индекс первого единичного бита или npos */
+    [[nodiscard]] size_t FindFirst() const noexcept {
+        return FindFromWord(0, ~Word{0});
+    }
+
+    /* индекс первого единичного бита после pos или npos */
+    [[nodiscard]] size_t FindNext(size_t pos) const noexcept {
+        ++pos;
+        if (pos >= size_) {
+            return npos;
+        }
+        return FindFromWord(pos / kWordBits, ~Word{0} << (pos % kWordBits));
+    }
+
+    /* поэлементные операции; размеры операндов должны совпадать */
+    BitVector& operator&=(const BitVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        Word* lhs_words = words_.begin();
+        const Word* rhs_words = rhs.words_.begin();
+        for (size_t i = 0; i < words_.Size(); ++i) {
+            lhs_words[i] &= rhs_words[i];
+        }
+        return *this;
+    }
+    BitVector& operator|=(const BitVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        Word* lhs_words = words_.begin();
+        const Word* rhs_words = rhs.words_.begin();
+        for (size_t i = 0; i < words_.Size(); ++i) {
+            lhs_words[i] |= rhs_words[i];
+        }
+        return *this;
+    }
+    BitVector& operator^=(const BitVector& rhs) noexcept {
+        assert(size_ == rhs.size_);
+        Word* lhs_words = words_.begin();
+        const Word* rhs_words = rhs.words_.begin();
+        for (size_t i = 0; i < words_.Size(); ++i) {
+            lhs_words[i] ^= rhs_words[i];
+        }
+        return *this;
+    }
+
+    /* инвертирует все биты (NOT) */
+    void Flip() noexcept {
+        for (Word& word : words_) {
+            word = ~word;
+        }
+        ClearTail();
+    }
+
+    friend bool operator==(const BitVector& lhs, const BitVector& rhs) noexcept {
+        return lhs.size_ == rhs.size_
+                && std::equal(lhs.words_.begin(), lhs.words_.end(), rhs.words_.begin());
+    }
+
+private:
+    self::Vector<Word> words_;
+    size_t size_ = 0;
+
+private:
+    static size_t WordsFor(size_t bits) noexcept {
+        return (bits + kWordBits - 1) / kWordBits;
+    }
+
+    static Word Mask(size_t index) noexcept {
+        return Word{1} << (index % kWordBits);
+    }
+
+    /* обнуляет биты последнего слова за пределами size_ */
+    void ClearTail() noexcept {
+        if (size_ % kWordBits != 0) {
+            words_[size_ / kWordBits] &= ~Word{0} >> (kWordBits - size_ % kWordBits);
+        }
+    }
+
+    /* выставляет биты [first, last) */
+    void SetRange(size_t first, size_t last) noexcept {
+        while (first < last && first % kWordBits != 0) {
+            words_[first / kWordBits] |= Mask(first);
+            ++first;
+        }
+        /* дальше first выровнен по слову, а хвостовые слова — новые */
+        if (first < last) {
+            std::fill(words_.begin() + first / kWordBits, words_.end(), ~Word{0});
+            ClearTail();
+        }
+    }
+
+    size_t FindFromWord(size_t word_index, Word first_mask) const noexcept {
+        if (word_index >= words_.Size()) {
+            return npos;
+        }
+        Word word = words_[word_index] & first_mask;
+        while (word == 0) {
+            if (++word_index == words_.Size()) {
+                return npos;
+            }
+            word = words_[word_index];
+        }
+        return word_index * kWordBits + static_cast<size_t>(std::countr_zero(word));
+    }
+};
+
+inline BitVector operator&(BitVector lhs, const BitVector& rhs) noexcept {
+    return lhs &= rhs;
+}
+inline BitVector operator|(BitVector lhs, const BitVector& rhs) noexcept {
+    return lhs |= rhs;
+}
+inline BitVector operator^(BitVector lhs, const BitVector& rhs) noexcept {
+    return lhs ^= rhs;
+}
+inline BitVector operator~(BitVector bits) noexcept {
+    bits.Flip();
+    return bits;
+}
+
+inline void swap(BitVector& lhs, BitVector& rhs) noexcept {
+    lhs.Swap(rhs);
+}
+
+/*
+    Индекс rank/select над неизменяемым BitVector: на каждые 512 бит хранится
+    число единиц до них (1/8 объема битов). Rank1 — один элемент индекса и до 8 popcount,
+    Select1 — бинарный поиск по индексу и выбор бита в слове (pdep при наличии BMI2).
+    После изменения BitVector индекс нужно построить заново.
+    Индекс хранит ссылку на BitVector, и тот должен его пережить
+*/
+class BitVectorRank {
+    static constexpr size_t kWordBits = 64;
+    static constexpr size_t kWordsPerBlock = 8;
+    static constexpr size_t kBlockBits = kWordBits * kWordsPerBlock;
+
+public:
+    explicit BitVectorRank(const BitVector& bits)
+            : bits_(bits) {
+        const size_t blocks = (bits.WordCount() + kWordsPerBlock - 1) / kWordsPerBlock;
+        ones_before_.Reserve(blocks + 1);
+        size_t ones = 0;
+        for (size_t word = 0; word < bits.WordCount(); ++word) {
+            if (word % kWordsPerBlock == 0) {
+                ones_before_.PushBack(ones);
+            }
+            ones += static_cast<size_t>(std::popcount(bits.Words()[word]));
+        }
+        ones_before_.PushBack(ones);
+    }
+
+    /* временный BitVector умер бы раньше индекса */
+    explicit BitVectorRank(BitVector&&) = delete;
+
+    /* число единиц среди битов [0, pos) */
+    [[nodiscard]] size_t Rank1(size_t pos) const noexcept {
+        assert(pos <= bits_.Size());
+        const size_t block = pos / kBlockBits;
+        size_t ones = ones_before_[block];
+        const uint64_t* words = bits_.Words();
+        const size_t last_word = pos / kWordBits;
+        for (size_t word = block * kWordsPerBlock; word < last_word; ++word) {
+            ones += static_cast<size_t>(std::popcount(words[word]));
+        }
+        if (pos % kWordBits != 0) {
+            ones += static_cast<size_t>(std::popcount(words[last_word] << (kWordBits - pos % kWordBits)));
+        }
+        return ones;
+    }
+
+    [[nodiscard]] size_t Rank0(size_t pos) const noexcept {
+        return pos - Rank1(pos);
+    }
+
+    /* позиция k-й (с нуля) единицы или BitVector::npos */
+    [[nodiscard]] size_t Select1(size_t k) const noexcept {
+        if (k >= ones_before_[ones_before_.Size() - 1]) {
+            return BitVector::npos;
+        }
+        /* последний блок, перед которым не больше k единиц */
+        auto it = std::upper_bound(ones_before_.begin(), ones_before_.end(), k);
+        const size_t block = static_cast<size_t>(it - ones_before_.begin()) - 1;
+        k -= ones_before_[block];
+
+        const uint64_t* words = bits_.Words();
+        size_t word = block * kWordsPerBlock;
+        for (;; ++word) {
+            const size_t ones = static_cast<size_t>(std::popcount(words[word]));
+            if (k < ones) {
+                break;
+            }
+            k -= ones;
+        }
+        return word * kWordBits + SelectInWord(words[word], k);
+    }
+
+private:
+    const BitVector& bits_;
+    self::Vector<size_t> ones_before_;
+
+private:
+    /* позиция k-й единицы в слове; единиц в слове должно быть больше k */
+    static size_t SelectInWord(uint64_t word, size_t k) noexcept {
+#if defined(__BMI2__)
+        return static_cast<size_t>(std::countr_zero(_pdep_u64(uint64_t{1} << k, word)));
+#else
+        for (; k != 0; --k) {
+            word &= word - 1;
+        }
+        return static_cast<size_t>(std::countr_zero(word));
+#endif
+    }
+};
+
+} // self
\ No newline at end of file
@@ -0,0 +1,453 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector/vector.h"
+
+namespace self {
+
+/*
+    Двусторонняя очередь из блоков фиксированного размера.
+    Блоки выделяются через RawMemory, указатели на них лежат в карте (self::Vector),
+    в которой занят непрерывный диапазон [first_block_, ...] с запасом с обеих сторон.
+    Вставка в любой конец никогда не перемещает элементы: при росте карты переезжают
+    только дескрипторы блоков, поэтому ссылки и указатели на элементы остаются
+    действительными (в отличие от self::Vector::OverflowPush).
+    Освободившиеся блоки складываются в небольшой кэш и переиспользуются,
+    так что очередь со скользящим окном после разогрева не обращается к аллокатору
+*/
+template <typename T>
+class Deque {
+    /* элементов в блоке: около 4 КиБ, но не меньше 16; степень двойки, чтобы деление было сдвигом */
+    static constexpr size_t kBlockSize = std::bit_floor(std::max<size_t>(16, 4096 / sizeof(T)));
+    /* сколько пустых блоков держать про запас */
+    static constexpr size_t kMaxSpareBlocks = 4;
+    static constexpr size_t kMinMapSize = 8;
+
+    template <typename ValueType>
+    class BasicIterator {
+        friend class Deque;
+        template <typename> friend class BasicIterator;
+
+        using DequePtr = std::conditional_t<std::is_const_v<ValueType>, const Deque*, Deque*>;
+
+        BasicIterator(DequePtr deque, size_t index) noexcept
+            : deque_(deque)
+            , index_(index) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        /* неконстантный итератор приводится к константному */
+        BasicIterator(const BasicIterator<T>& other) noexcept
+            : deque_(other.deque_)
+            , index_(other.index_) {}
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return (*deque_)[index_];
+        }
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &(*deque_)[index_];
+        }
+        [[nodiscard]] reference operator[](difference_type n) const noexcept {
+            return (*deque_)[index_ + n];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        BasicIterator operator++(int) noexcept {
+            auto copy(*this);
+            ++index_;
+            return copy;
+        }
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        BasicIterator operator--(int) noexcept {
+            auto copy(*this);
+            --index_;
+            return copy;
+        }
+        BasicIterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+        BasicIterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+        [[nodiscard]] friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        [[nodiscard]] friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+            return it += n;
+        }
+        [[nodiscard]] friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        [[nodiscard]] friend difference_type operator-(const BasicIterator& lhs,
+                                                       const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator& rhs) const noexcept {
+            return index_ == rhs.index_;
+        }
+        [[nodiscard]] auto operator<=>(const BasicIterator& rhs) const noexcept {
+            return index_ <=> rhs.index_;
+        }
+
+    private:
+        DequePtr deque_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = T;
+    using iterator = BasicIterator<T>;
+    using const_iterator = BasicIterator<const T>;
+
+    Deque() = default;
+
+    Deque(std::initializer_list<T> items) {
+        for (const T& item : items) {
+            PushBack(item);
+        }
+    }
+
+    Deque(const Deque& other) {
+        for (const T& item : other) {
+            PushBack(item);
+        }
+    }
+
+    Deque(Deque&& other) noexcept {
+        Swap(other);
+    }
+
+    Deque& operator=(const Deque& rhs) {
+        if (this != &rhs) {
+            /* copy-and-swap идиома */
+            Deque rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    Deque& operator=(Deque&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    ~Deque() {
+        Clear();
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *Slot(index);
+    }
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<Deque&>(*this)[index];
+    }
+
+    T& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Deque index out of range");
+        }
+        return (*this)[index];
+    }
+    const T& At(size_t index) const {
+        return const_cast<Deque&>(*this).At(index);
+    }
+
+    T& Front() noexcept {
+        return (*this)[0];
+    }
+    const T& Front() const noexcept {
+        return (*this)[0];
+    }
+    T& Back() noexcept {
+        return (*this)[size_ - 1];
+    }
+    const T& Back() const noexcept {
+        return (*this)[size_ - 1];
+    }
+
+    void Swap(Deque& other) noexcept {
+        map_.Swap(other.map_);
+        spare_.Swap(other.spare_);
+        std::swap(first_block_, other.first_block_);
+        std::swap(front_, other.front_);
+        std::swap(size_, other.size_);
+    }
+
+    void Clear() noexcept {
+        while (size_) {
+            PopBack();
+        }
+    }
+
+    /* отдает аллокатору блоки из кэша */
+    void ShrinkToFit() noexcept {
+        spare_.Reset();
+    }
+
+    /* так же, как у Vector: универсальная ссылка вместо пары перегрузок */
+    template <typename U>
+    void PushBack(U&& value) {
+        EmplaceBack(std::forward<U>(value));
+    }
+
+    template <typename U>
+    void PushFront(U&& value) {
+        EmplaceFront(std::forward<U>(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == 0) {
+            return EmplaceIntoEmpty(0, std::forward<Args>(args)...);
+        }
+        const size_t pos = front_ + size_;
+        if (pos % kBlockSize != 0) {
+            T* slot = new (Slot(size_)) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+        /* последний блок заполнен */
+        if (first_block_ + pos / kBlockSize == map_.Size()) {
+            GrowMap();
+        }
+        const size_t block = first_block_ + pos / kBlockSize;
+        AcquireBlock(block);
+        try {
+            T* slot = new (map_[block].GetAddress()) T(std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        } catch (...) {
+            ReleaseBlock(block);
+            throw;
+        }
+    }
+
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        if (size_ == 0) {
+            return EmplaceIntoEmpty(kBlockSize - 1, std::forward<Args>(args)...);
+        }
+        if (front_ != 0) {
+            T* slot = new (map_[first_block_] + (front_ - 1)) T(std::forward<Args>(args)...);
+            --front_;
+            ++size_;
+            return *slot;
+        }
+        /* первый блок заполнен от начала */
+        if (first_block_ == 0) {
+            GrowMap();
+        }
+        const size_t block = first_block_ - 1;
+        AcquireBlock(block);
+        try {
+            T* slot = new (map_[block] + (kBlockSize - 1)) T(std::forward<Args>(args)...);
+            first_block_ = block;
+            front_ = kBlockSize - 1;
+            ++size_;
+            return *slot;
+        } catch (...) {
+            ReleaseBlock(block);
+            throw;
+        }
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        Slot(size_ - 1)->~T();
+        --size_;
+        if (size_ == 0) {
+            ReleaseLastBlock();
+        } else if ((front_ + size_) % kBlockSize == 0) {
+            ReleaseBlock(first_block_ + (front_ + size_) / kBlockSize);
+        }
+    }
+
+    void PopFront() noexcept {
+        assert(size_ != 0);
+        Slot(0)->~T();
+        ++front_;
+        --size_;
+        if (size_ == 0) {
+            ReleaseLastBlock();
+        } else if (front_ == kBlockSize) {
+            ReleaseBlock(first_block_);
+            ++first_block_;
+            front_ = 0;
+        }
+    }
+
+private:
+    /* дескрипторы блоков; занят только диапазон, покрывающий элементы */
+    self::Vector<RawMemory<T>> map_;
+    /* кэш пустых блоков */
+    self::Vector<RawMemory<T>> spare_;
+    size_t first_block_ = 0;
+    /* смещение первого элемента внутри блока first_block_ */
+    size_t front_ = 0;
+    size_t size_ = 0;
+
+private:
+    T* Slot(size_t index) noexcept {
+        const size_t pos = front_ + index;
+        return map_[first_block_ + pos / kBlockSize] + pos % kBlockSize;
+    }
+
+    template <typename... Args>
+    T& EmplaceIntoEmpty(size_t offset, Args&&... args) {
+        if (map_.Size() == 0) {
+            GrowMap();
+        }
+        AcquireBlock(first_block_);
+        try {
+            T* slot = new (map_[first_block_] + offset) T(std::forward<Args>(args)...);
+            front_ = offset;
+            size_ = 1;
+            return *slot;
+        } catch (...) {
+            ReleaseBlock(first_block_);
+            throw;
+        }
+    }
+
+    void AcquireBlock(size_t index) {
+        if (spare_.Size()) {
+            map_[index] = std::move(spare_[spare_.Size() - 1]);
+            spare_.PopBack();
+        } else {
+            map_[index] = RawMemory<T>(kBlockSize);
+        }
+    }
+
+    void ReleaseBlock(size_t index) noexcept {
+        if (spare_.Size() < kMaxSpareBlocks) {
+            /* емкость spare_ резервируется в GrowMap, так что здесь нет аллокаций */
+            spare_.PushBack(std::move(map_[index]));
+        } else {
+            /* присваивание перемещением меняет буферы местами, старый освободит временный объект */
+            map_[index] = RawMemory<T>();
+        }
+    }
+
+    /* очередь опустела: отдаем последний блок и возвращаемся в середину карты */
+    void ReleaseLastBlock() noexcept {
+        ReleaseBlock(first_block_);
+        first_block_ = map_.Size() / 2;
+        front_ = 0;
+    }
+
+    /*
+        Освобождает место у края карты. Если карта хотя бы вдвое больше занятой
+        части, блоки сдвигаются к ее середине без аллокаций: скользящее окно
+        упирается в край постоянно, и новая карта на каждый такой раз свела бы
+        на нет кэш блоков. Иначе блоки переносятся в новую карту с запасом
+        по бокам не меньше половины занятой части. В обоих случаях перестройка
+        стоит O(блоков) и случается не чаще, чем раз в столько же добавленных блоков
+    */
+    void GrowMap() {
+        const size_t used = size_ == 0 ? 0 : (front_ + size_ - 1) / kBlockSize + 1;
+        if (map_.Size() >= 2 * used + 2) {
+            RecenterMap(used);
+            return;
+        }
+        const size_t new_size = std::max(kMinMapSize, 2 * used + 2);
+        const size_t new_first = (new_size - used) / 2;
+
+        self::Vector<RawMemory<T>> new_map(new_size);
+        for (size_t i = 0; i < used; ++i) {
+            new_map[new_first + i] = std::move(map_[first_block_ + i]);
+        }
+        spare_.Reserve(kMaxSpareBlocks);
+        map_.Swap(new_map);
+        first_block_ = new_first;
+    }
+
+    /*
+        Сдвигает used занятых дескрипторов к середине карты. RawMemory перемещается
+        обменом, а свободные дескрипторы пусты, поэтому сдвиг с перекрытием в нужную
+        сторону оставляет позади только пустые дескрипторы
+    */
+    void RecenterMap(size_t used) noexcept {
+        const size_t new_first = (map_.Size() - used) / 2;
+        if (new_first < first_block_) {
+            for (size_t i = 0; i < used; ++i) {
+                map_[new_first + i] = std::move(map_[first_block_ + i]);
+            }
+        } else {
+            for (size_t i = used; i-- > 0;) {
+                map_[new_first + i] = std::move(map_[first_block_ + i]);
+            }
+        }
+        first_block_ = new_first;
+    }
+};
+
+template <typename T>
+void swap(Deque<T>& lhs, Deque<T>& rhs) noexcept {
+    lhs.Swap(rhs);
+}
+
+template <typename T>
+bool operator==(const Deque<T>& lhs, const Deque<T>& rhs) {
+    return lhs.Size() == rhs.Size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T>
+bool operator!=(const Deque<T>& lhs, const Deque<T>& rhs) {
+    return !(lhs == rhs);
+}
+
+} // self
\ No newline at end of file
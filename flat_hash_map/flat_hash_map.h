@@ -0,0 +1,685 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "vector/vector.h"
+
+namespace self {
+
+namespace detail {
+
+/*
+    Управляющий байт слота. Занятый слот хранит 7 младших бит хэша (H2, 0..127),
+    свободные — отрицательные значения, поэтому "занят/свободен" — это знаковый бит
+*/
+using ctrl_t = int8_t;
+inline constexpr ctrl_t kCtrlEmpty = -128;
+inline constexpr ctrl_t kCtrlDeleted = -2;
+
+/* слоты сгруппированы по 16: управляющие байты группы сравниваются одной SSE2-инструкцией */
+inline constexpr size_t kGroupWidth = 16;
+
+/* маска совпадений в группе: бит i выставлен, если подошел i-й слот */
+class GroupMask {
+public:
+    explicit GroupMask(uint32_t mask) noexcept
+        : mask_(mask) {}
+
+    explicit operator bool() const noexcept {
+        return mask_ != 0;
+    }
+    /* номер младшего подошедшего слота */
+    size_t Lowest() const noexcept {
+        return static_cast<size_t>(std::countr_zero(mask_));
+    }
+    void ClearLowest() noexcept {
+        mask_ &= mask_ - 1;
+    }
+
+private:
+    uint32_t mask_;
+};
+
+class Group {
+public:
+    explicit Group(const ctrl_t* ctrl) noexcept {
+#if defined(__SSE2__)
+        ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        std::memcpy(ctrl_, ctrl, kGroupWidth);
+#endif
+    }
+
+    GroupMask Match(ctrl_t h2) const noexcept {
+#if defined(__SSE2__)
+        return GroupMask(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+#else
+        return MatchIf([h2](ctrl_t c) { return c == h2; });
+#endif
+    }
+
+    GroupMask MatchEmpty() const noexcept {
+        return Match(kCtrlEmpty);
+    }
+
+    GroupMask MatchEmptyOrDeleted() const noexcept {
+#if defined(__SSE2__)
+        /* kCtrlEmpty и kCtrlDeleted — единственные значения меньше -1 */
+        return GroupMask(static_cast<uint32_t>(
+                _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_))));
+#else
+        return MatchIf([](ctrl_t c) { return c < -1; });
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i ctrl_;
+#else
+    template <typename Pred>
+    GroupMask MatchIf(Pred pred) const noexcept {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= static_cast<uint32_t>(pred(ctrl_[i])) << i;
+        }
+        return GroupMask(mask);
+    }
+
+    ctrl_t ctrl_[kGroupWidth];
+#endif
+};
+
+template <typename T, typename = void>
+inline constexpr bool kIsTransparent = false;
+template <typename T>
+inline constexpr bool kIsTransparent<T, std::void_t<typename T::is_transparent>> = true;
+
+/*
+    Слот таблицы. Снаружи видна только value — pair<const K, V>, поэтому ключ
+    нельзя поменять через итератор. При перехэшировании пара перемещается
+    через mutable_value: раскладка у обеих пар одна, а ключ не копируется
+*/
+template <typename K, typename V>
+union MapSlot {
+    MapSlot() {}
+    ~MapSlot() {}
+
+    std::pair<const K, V> value;
+    std::pair<K, V> mutable_value;
+};
+
+inline void Prefetch(const void* address) noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+} // detail
+
+/*
+    Хэш-таблица с открытой адресацией в духе SwissTable.
+    Пары ключ-значение лежат подряд в RawMemory, рядом — отдельный массив
+    управляющих байт. Поиск сравнивает 16 управляющих байт за раз и обращается
+    к самим слотам только при совпадении 7 бит хэша, поэтому обычно это
+    один промах кэша. Удаление оставляет tombstone только если группа
+    полностью заполнена, иначе слот сразу становится пустым.
+
+    Как и в std::unordered_map, value_type — pair<const K, V>: ключ через
+    итератор не меняется.
+    Если Hash и KeyEqual объявляют is_transparent, поиск принимает любой
+    сравнимый с ключом тип без создания временного K
+*/
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+    using ctrl_t = detail::ctrl_t;
+    using Slot = detail::MapSlot<K, V>;
+
+    static constexpr bool kTransparent =
+            detail::kIsTransparent<Hash> && detail::kIsTransparent<KeyEqual>;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+
+private:
+    template <typename ValueType>
+    class BasicIterator {
+        friend class FlatHashMap;
+        template <typename> friend class BasicIterator;
+
+        using SlotType = std::conditional_t<std::is_const_v<ValueType>, const Slot, Slot>;
+
+        BasicIterator(const ctrl_t* ctrl, SlotType* slot, const ctrl_t* ctrl_end) noexcept
+            : ctrl_(ctrl)
+            , slot_(slot)
+            , ctrl_end_(ctrl_end) {
+            SkipEmpty();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        /* неконстантный итератор приводится к константному */
+        BasicIterator(const BasicIterator<value_type>& other) noexcept
+            : ctrl_(other.ctrl_)
+            , slot_(other.slot_)
+            , ctrl_end_(other.ctrl_end_) {}
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] bool operator==(const BasicIterator& rhs) const noexcept {
+            return ctrl_ == rhs.ctrl_;
+        }
+        [[nodiscard]] bool operator!=(const BasicIterator& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            SkipEmpty();
+            return *this;
+        }
+        BasicIterator operator++(int) noexcept {
+            auto copy(*this);
+            ++(*this);
+            return copy;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return slot_->value;
+        }
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &slot_->value;
+        }
+
+    private:
+        void SkipEmpty() noexcept {
+            while (ctrl_ != ctrl_end_ && *ctrl_ < 0) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+        const ctrl_t* ctrl_ = nullptr;
+        SlotType* slot_ = nullptr;
+        const ctrl_t* ctrl_end_ = nullptr;
+    };
+
+public:
+    using iterator = BasicIterator<value_type>;
+    using const_iterator = BasicIterator<const value_type>;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(size_t size, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+            : hasher_(hash)
+            , key_equal_(eq) {
+        Reserve(size);
+    }
+
+    FlatHashMap(std::initializer_list<value_type> items) {
+        InsertMany(items.begin(), items.end());
+    }
+
+    FlatHashMap(const FlatHashMap& other)
+            : hasher_(other.hasher_)
+            , key_equal_(other.key_equal_) {
+        if (other.size_ == 0) {
+            return;
+        }
+        /* при той же емкости раскладка слотов совпадает, поэтому копируем их по месту */
+        RawMemory<ctrl_t> ctrl(other.Capacity());
+        RawMemory<Slot> slots(other.Capacity());
+        std::memcpy(ctrl.GetAddress(), other.ctrl_.GetAddress(), other.Capacity());
+        size_t constructed = 0;
+        try {
+            for (; constructed < other.Capacity(); ++constructed) {
+                if (ctrl[constructed] >= 0) {
+                    new (&slots[constructed].value) value_type(other.slots_[constructed].value);
+                }
+            }
+        } catch (...) {
+            for (size_t i = 0; i < constructed; ++i) {
+                if (ctrl[i] >= 0) {
+                    slots[i].value.~value_type();
+                }
+            }
+            throw;
+        }
+        ctrl_.Swap(ctrl);
+        slots_.Swap(slots);
+        size_ = other.size_;
+        growth_left_ = other.growth_left_;
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept {
+        Swap(other);
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& rhs) {
+        if (this != &rhs) {
+            /* copy-and-swap идиома */
+            FlatHashMap rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        DestroySlots();
+    }
+
+    iterator begin() noexcept {
+        return iterator(ctrl_.GetAddress(), slots_.GetAddress(), ctrl_ + Capacity());
+    }
+    iterator end() noexcept {
+        return iterator(ctrl_ + Capacity(), slots_ + Capacity(), ctrl_ + Capacity());
+    }
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return const_cast<FlatHashMap&>(*this).begin();
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return const_cast<FlatHashMap&>(*this).end();
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+    /* число слотов; вставлять без перехэширования можно до 7/8 от него */
+    [[nodiscard]] size_t Capacity() const noexcept {
+        return ctrl_.Capacity();
+    }
+
+    void Clear() noexcept {
+        DestroySlots();
+        if (Capacity()) {
+            std::memset(ctrl_.GetAddress(), static_cast<unsigned char>(detail::kCtrlEmpty), Capacity());
+        }
+        size_ = 0;
+        growth_left_ = MaxLoad(Capacity());
+    }
+
+    void Swap(FlatHashMap& other) noexcept {
+        ctrl_.Swap(other.ctrl_);
+        slots_.Swap(other.slots_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+        std::swap(hasher_, other.hasher_);
+        std::swap(key_equal_, other.key_equal_);
+    }
+
+    /* гарантирует, что size элементов поместятся без перехэширования */
+    void Reserve(size_t size) {
+        if (size > size_ + growth_left_) {
+            Rehash(CapacityFor(size));
+        }
+    }
+
+    /*
+        Вставляет пару (key, V(args...)), если ключа еще нет.
+        Возвращает итератор на элемент с этим ключом и флаг вставки
+    */
+    template <typename KeyArg, typename... Args>
+    std::pair<iterator, bool> TryEmplace(KeyArg&& key, Args&&... args) {
+        if constexpr (!std::is_same_v<std::remove_cvref_t<KeyArg>, K> && !kTransparent) {
+            /* без прозрачного хэша ключ сначала приводится к K */
+            return TryEmplace(K(std::forward<KeyArg>(key)), std::forward<Args>(args)...);
+        } else {
+            const size_t hash = HashOf(key);
+            return TryEmplaceHashed(hash, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+        }
+    }
+
+    /* P — value_type или совместимая пара */
+    template <typename P>
+    std::pair<iterator, bool> Insert(P&& value) {
+        return TryEmplace(std::forward<P>(value).first, std::forward<P>(value).second);
+    }
+
+    /*
+        Пакетная вставка: емкость резервируется один раз, а управляющие группы
+        следующей порции ключей запрашиваются prefetch'ем заранее. Хэши порции
+        считаются один раз и переиспользуются при вставке
+    */
+    template <typename InputIt>
+    void InsertMany(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        using KeyArg = std::remove_cvref_t<decltype((*first).first)>;
+        /* ключ другого типа без прозрачного хэша все равно приводится к K по одному */
+        constexpr bool kHashDirectly = std::is_same_v<KeyArg, K> || kTransparent;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category> && kHashDirectly) {
+            Reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+            constexpr size_t kBatch = 8;
+            size_t hashes[kBatch];
+            while (first != last) {
+                InputIt batch_end = first;
+                size_t count = 0;
+                for (; count < kBatch && batch_end != last; ++count, ++batch_end) {
+                    hashes[count] = HashOf((*batch_end).first);
+                    detail::Prefetch(ctrl_ + GroupStart(H1(hashes[count])));
+                }
+                for (size_t i = 0; i < count; ++i, ++first) {
+                    auto&& item = *first;
+                    TryEmplaceHashed(hashes[i], std::forward<decltype(item)>(item).first,
+                                     std::forward<decltype(item)>(item).second);
+                }
+            }
+        } else {
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+                Reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) {
+                Insert(*first);
+            }
+        }
+    }
+
+    V& operator[](const K& key) {
+        return TryEmplace(key).first->second;
+    }
+    V& operator[](K&& key) {
+        return TryEmplace(std::move(key)).first->second;
+    }
+
+    V& At(const K& key) {
+        iterator it = Find(key);
+        if (it == end()) {
+            throw std::out_of_range("FlatHashMap key not found");
+        }
+        return it->second;
+    }
+    const V& At(const K& key) const {
+        return const_cast<FlatHashMap&>(*this).At(key);
+    }
+
+    iterator Find(const K& key) {
+        return FindImpl(key);
+    }
+    const_iterator Find(const K& key) const {
+        return const_cast<FlatHashMap&>(*this).FindImpl(key);
+    }
+    template <typename Q> requires kTransparent
+    iterator Find(const Q& key) {
+        return FindImpl(key);
+    }
+    template <typename Q> requires kTransparent
+    const_iterator Find(const Q& key) const {
+        return const_cast<FlatHashMap&>(*this).FindImpl(key);
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+    template <typename Q> requires kTransparent
+    bool Contains(const Q& key) const {
+        return Find(key) != end();
+    }
+
+    /* возвращает итератор на следующий элемент */
+    iterator Erase(const_iterator pos) {
+        size_t index = static_cast<size_t>(pos.ctrl_ - ctrl_.GetAddress());
+        EraseAt(index);
+        /* итератор сам перешагнет освободившийся слот */
+        return IteratorAt(index);
+    }
+
+    /* возвращает число удаленных элементов (0 или 1) */
+    size_t Erase(const K& key) {
+        return EraseKey(key);
+    }
+    template <typename Q> requires (kTransparent && !std::is_convertible_v<const Q&, const_iterator>)
+    size_t Erase(const Q& key) {
+        return EraseKey(key);
+    }
+
+private:
+    RawMemory<ctrl_t> ctrl_;
+    RawMemory<Slot> slots_;
+    size_t size_ = 0;
+    /* сколько еще пустых слотов можно занять до перехэширования */
+    size_t growth_left_ = 0;
+    [[no_unique_address]] Hash hasher_;
+    [[no_unique_address]] KeyEqual key_equal_;
+
+private:
+    static size_t MaxLoad(size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+    static size_t CapacityFor(size_t size) noexcept {
+        size_t capacity = detail::kGroupWidth;
+        while (MaxLoad(capacity) < size) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    template <typename Q>
+    size_t HashOf(const Q& key) const {
+        /* перемешиваем: std::hash для целых — тождественная функция */
+        uint64_t h = static_cast<uint64_t>(hasher_(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+    static size_t H1(size_t hash) noexcept {
+        return hash >> 7;
+    }
+    static ctrl_t H2(size_t hash) noexcept {
+        return static_cast<ctrl_t>(hash & 0x7F);
+    }
+
+    size_t GroupCount() const noexcept {
+        return Capacity() / detail::kGroupWidth;
+    }
+    /* начало первой группы в последовательности проб для H1 */
+    size_t GroupStart(size_t h1) const noexcept {
+        return (h1 & (GroupCount() - 1)) * detail::kGroupWidth;
+    }
+
+    void SetCtrl(size_t index, ctrl_t value) noexcept {
+        ctrl_[index] = value;
+    }
+
+    iterator IteratorAt(size_t index) noexcept {
+        return iterator(ctrl_ + index, slots_ + index, ctrl_ + Capacity());
+    }
+
+    /*
+        Обход групп идет по треугольным числам: при числе групп, равном степени
+        двойки, так посещается каждая группа ровно один раз
+    */
+    template <typename Q>
+    size_t FindIndex(const Q& key, size_t hash) const {
+        if (Capacity() == 0) {
+            return Capacity();
+        }
+        const size_t group_mask = GroupCount() - 1;
+        size_t group = H1(hash) & group_mask;
+        for (size_t step = 1; step <= GroupCount(); ++step) {
+            const size_t base = group * detail::kGroupWidth;
+            detail::Group g(ctrl_ + base);
+            for (auto match = g.Match(H2(hash)); match; match.ClearLowest()) {
+                const size_t index = base + match.Lowest();
+                if (key_equal_(slots_[index].value.first, key)) {
+                    return index;
+                }
+            }
+            if (g.MatchEmpty()) {
+                break;
+            }
+            group = (group + step) & group_mask;
+        }
+        return Capacity();
+    }
+
+    template <typename Q>
+    iterator FindImpl(const Q& key) {
+        return IteratorAt(FindIndex(key, HashOf(key)));
+    }
+
+    /* первый пустой или удаленный слот в последовательности проб */
+    size_t FindFirstNonFull(size_t hash) const noexcept {
+        const size_t group_mask = GroupCount() - 1;
+        size_t group = H1(hash) & group_mask;
+        for (size_t step = 1;; ++step) {
+            const size_t base = group * detail::kGroupWidth;
+            auto mask = detail::Group(ctrl_ + base).MatchEmptyOrDeleted();
+            if (mask) {
+                return base + mask.Lowest();
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+
+    /* TryEmplace с уже посчитанным хэшем ключа */
+    template <typename KeyArg, typename... Args>
+    std::pair<iterator, bool> TryEmplaceHashed(size_t hash, KeyArg&& key, Args&&... args) {
+        auto [index, inserted] = FindOrPrepareInsert(key, hash);
+        if (inserted) {
+            new (&slots_[index].value) value_type(std::piecewise_construct,
+                    std::forward_as_tuple(std::forward<KeyArg>(key)),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+            SetCtrl(index, H2(hash));
+            ++size_;
+        }
+        return {IteratorAt(index), inserted};
+    }
+
+    /*
+        Возвращает индекс найденного ключа и false, либо индекс слота,
+        подготовленного под вставку, и true. Слот еще не помечен занятым
+    */
+    template <typename Q>
+    std::pair<size_t, bool> FindOrPrepareInsert(const Q& key, size_t hash) {
+        size_t index = FindIndex(key, hash);
+        if (index != Capacity()) {
+            return {index, false};
+        }
+        if (growth_left_ == 0) {
+            GrowOrCompact();
+        }
+        index = FindFirstNonFull(hash);
+        /* занятие tombstone'а не уменьшает запас пустых слотов */
+        if (ctrl_[index] == detail::kCtrlEmpty) {
+            --growth_left_;
+        }
+        return {index, true};
+    }
+
+    void GrowOrCompact() {
+        if (Capacity() == 0) {
+            Rehash(detail::kGroupWidth);
+        } else if (size_ <= MaxLoad(Capacity()) / 2) {
+            /* больше половины запаса съели tombstone'ы: перехэшируем на месте */
+            Rehash(Capacity());
+        } else {
+            Rehash(Capacity() * 2);
+        }
+    }
+
+    void Rehash(size_t new_capacity) {
+        assert(new_capacity >= detail::kGroupWidth && std::has_single_bit(new_capacity));
+        RawMemory<ctrl_t> old_ctrl(new_capacity);
+        RawMemory<Slot> old_slots(new_capacity);
+        std::memset(old_ctrl.GetAddress(), static_cast<unsigned char>(detail::kCtrlEmpty), new_capacity);
+        /* после обмена old_* указывают на прежние массивы */
+        ctrl_.Swap(old_ctrl);
+        slots_.Swap(old_slots);
+        growth_left_ = MaxLoad(new_capacity) - size_;
+
+        for (size_t i = 0; i < old_ctrl.Capacity(); ++i) {
+            if (old_ctrl[i] < 0) {
+                continue;
+            }
+            auto& slot = old_slots[i].mutable_value;
+            const size_t hash = HashOf(slot.first);
+            const size_t index = FindFirstNonFull(hash);
+            new (&slots_[index].mutable_value) std::pair<K, V>(std::move(slot));
+            slot.~pair();
+            SetCtrl(index, H2(hash));
+        }
+    }
+
+    void EraseAt(size_t index) {
+        slots_[index].value.~value_type();
+        --size_;
+        /*
+            Если в группе уже есть пустой слот, поиск любого ключа
+            на этой группе и так остановится — tombstone не нужен
+        */
+        const size_t base = index - index % detail::kGroupWidth;
+        if (detail::Group(ctrl_ + base).MatchEmpty()) {
+            SetCtrl(index, detail::kCtrlEmpty);
+            ++growth_left_;
+        } else {
+            SetCtrl(index, detail::kCtrlDeleted);
+        }
+    }
+
+    template <typename Q>
+    size_t EraseKey(const Q& key) {
+        const size_t index = FindIndex(key, HashOf(key));
+        if (index == Capacity()) {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+    void DestroySlots() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_t i = 0; i < Capacity(); ++i) {
+                if (ctrl_[i] >= 0) {
+                    slots_[i].value.~value_type();
+                }
+            }
+        }
+    }
+};
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void swap(FlatHashMap<K, V, Hash, KeyEqual>& lhs, FlatHashMap<K, V, Hash, KeyEqual>& rhs) noexcept {
+    lhs.Swap(rhs);
+}
+
+} // self
\ No newline at end of file
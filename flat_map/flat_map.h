@@ -0,0 +1,483 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "vector/vector.h"
+
+namespace self {
+
+namespace detail {
+
+/*
+    Раскладка Эйтцингера: элементы отсортированного массива расставлены в порядке
+    обхода в ширину неявного бинарного дерева (корень в позиции 1, потомки k — 2k и 2k+1).
+    Путь поиска идет от начала массива к концу, а четыре следующих уровня пути
+    лежат в одной кэш-линии, поэтому их можно запросить prefetch'ем заранее
+*/
+inline size_t FillEytzingerOrder(self::Vector<size_t>& order, size_t sorted_index, size_t k) {
+    if (k <= order.Size()) {
+        sorted_index = FillEytzingerOrder(order, sorted_index, 2 * k);
+        order[k - 1] = sorted_index++;
+        sorted_index = FillEytzingerOrder(order, sorted_index, 2 * k + 1);
+    }
+    return sorted_index;
+}
+
+/* order[i] — индекс в отсортированном массиве элемента, стоящего на i-м месте раскладки */
+inline self::Vector<size_t> EytzingerOrder(size_t size) {
+    self::Vector<size_t> order(size);
+    FillEytzingerOrder(order, 0, 1);
+    return order;
+}
+
+inline self::Vector<size_t> InvertPermutation(const self::Vector<size_t>& order) {
+    self::Vector<size_t> inverse(order.Size());
+    for (size_t i = 0; i < order.Size(); ++i) {
+        inverse[order[i]] = i;
+    }
+    return inverse;
+}
+
+/* values[i] = старое values[order[i]] */
+template <typename T>
+void ApplyPermutation(self::Vector<T>& values, const self::Vector<size_t>& order) {
+    self::Vector<T> permuted;
+    permuted.Reserve(values.Size());
+    for (size_t i = 0; i < order.Size(); ++i) {
+        permuted.PushBack(std::move(values[order[i]]));
+    }
+    values = std::move(permuted);
+}
+
+/*
+    Индекс первого элемента раскладки Эйтцингера, не меньшего key, или size.
+    Спуск без ветвлений: направление — это очередной бит k, а в конце
+    лишние правые повороты снимаются сдвигом
+*/
+template <typename T, typename Q, typename Compare>
+size_t EytzingerLowerBound(const T* data, size_t size, const Q& key, const Compare& comp) {
+    /* сколько элементов влезает в кэш-линию: через столько уровней спуск дойдет до prefetch'а */
+    constexpr size_t kStride = sizeof(T) >= 64 ? 1 : 64 / sizeof(T);
+    size_t k = 1;
+    while (k <= size) {
+#if defined(__GNUC__)
+        if (k * kStride <= size) {
+            __builtin_prefetch(data + k * kStride - 1);
+        }
+#endif
+        k = 2 * k + static_cast<size_t>(comp(data[k - 1], key));
+    }
+    k >>= std::countr_one(k) + 1;
+    return k == 0 ? size : k - 1;
+}
+
+/*
+    Общая часть FlatSet и FlatMap: отсортированные ключи в self::Vector
+    и, после Freeze(), их раскладка Эйтцингера
+*/
+template <typename K, typename Compare>
+class SortedKeys {
+public:
+    SortedKeys() = default;
+    explicit SortedKeys(const Compare& comp)
+        : comp_(comp) {}
+
+    SortedKeys(const SortedKeys& other) = default;
+
+    SortedKeys(SortedKeys&& other) noexcept {
+        SwapKeys(other);
+    }
+
+    SortedKeys& operator=(const SortedKeys& rhs) = default;
+
+    SortedKeys& operator=(SortedKeys&& rhs) noexcept {
+        SwapKeys(rhs);
+        return *this;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept {
+        return keys_.Size();
+    }
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return keys_.Size() == 0;
+    }
+    [[nodiscard]] bool IsFrozen() const noexcept {
+        return frozen_;
+    }
+    const self::Vector<K>& Keys() const noexcept {
+        return keys_;
+    }
+
+    /* индекс ключа в keys_ или Size(), если его нет */
+    size_t IndexOf(const K& key) const {
+        size_t index = frozen_
+                ? EytzingerLowerBound(keys_.begin(), keys_.Size(), key, comp_)
+                : static_cast<size_t>(LowerBound(key) - keys_.begin());
+        if (index != keys_.Size() && !comp_(key, keys_[index])) {
+            return index;
+        }
+        return keys_.Size();
+    }
+
+protected:
+    self::Vector<K> keys_;
+    [[no_unique_address]] Compare comp_;
+    bool frozen_ = false;
+
+protected:
+    typename self::Vector<K>::const_iterator LowerBound(const K& key) const {
+        return std::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+    }
+
+    bool Equivalent(const K& lhs, const K& rhs) const {
+        return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+    }
+
+    void SwapKeys(SortedKeys& other) noexcept {
+        keys_.Swap(other.keys_);
+        std::swap(comp_, other.comp_);
+        std::swap(frozen_, other.frozen_);
+    }
+};
+
+} // detail
+
+/*
+    Множество поверх отсортированного self::Vector. Для словарей, которые
+    собираются один раз и потом много раз опрашиваются:
+    - InsertMany сортирует пачку и сливает ее с имеющимися ключами за один проход,
+      вместо сдвига хвоста на каждую вставку;
+    - Freeze() переставляет ключи в раскладку Эйтцингера, после чего поиск идет
+      без ветвлений и с prefetch'ем. Любое изменение сначала возвращает
+      отсортированный порядок (Thaw), так что замораживать стоит после наполнения.
+    Итерация идет в порядке хранения: отсортированном или, после Freeze(), BFS
+*/
+template <typename K, typename Compare = std::less<K>>
+class FlatSet : public detail::SortedKeys<K, Compare> {
+    using Base = detail::SortedKeys<K, Compare>;
+
+public:
+    using value_type = K;
+    using const_iterator = const K*;
+    using iterator = const_iterator;
+
+    FlatSet() = default;
+    explicit FlatSet(const Compare& comp)
+        : Base(comp) {}
+    FlatSet(std::initializer_list<K> items) {
+        InsertMany(items.begin(), items.end());
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return this->keys_.begin();
+    }
+    [[nodiscard]] const_iterator end() const noexcept {
+        return this->keys_.end();
+    }
+    [[nodiscard]] const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    [[nodiscard]] const_iterator cend() const noexcept {
+        return end();
+    }
+
+    void Reserve(size_t capacity) {
+        this->keys_.Reserve(capacity);
+    }
+
+    void Clear() {
+        this->keys_.Reset();
+        this->frozen_ = false;
+    }
+
+    void Swap(FlatSet& other) noexcept {
+        this->SwapKeys(other);
+    }
+
+    /* возвращает false, если такой ключ уже был */
+    template <typename U>
+    bool Insert(U&& key) {
+        Thaw();
+        auto pos = this->LowerBound(key);
+        if (pos != end() && !this->comp_(key, *pos)) {
+            return false;
+        }
+        this->keys_.Insert(pos, std::forward<U>(key));
+        return true;
+    }
+
+    template <typename InputIt>
+    void InsertMany(InputIt first, InputIt last) {
+        Thaw();
+        self::Vector<K> batch;
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            batch.Reserve(static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            batch.PushBack(*first);
+        }
+        std::sort(batch.begin(), batch.end(), this->comp_);
+
+        /* слияние с пропуском дубликатов: и внутри пачки, и с имеющимися ключами */
+        self::Vector<K> merged;
+        merged.Reserve(this->keys_.Size() + batch.Size());
+        auto it = this->keys_.begin();
+        for (K& key : batch) {
+            while (it != this->keys_.end() && this->comp_(*it, key)) {
+                merged.PushBack(std::move(*it++));
+            }
+            bool duplicate = (it != this->keys_.end() && !this->comp_(key, *it))
+                    || (merged.Size() && this->Equivalent(merged[merged.Size() - 1], key));
+            if (!duplicate) {
+                merged.PushBack(std::move(key));
+            }
+        }
+        for (; it != this->keys_.end(); ++it) {
+            merged.PushBack(std::move(*it));
+        }
+        this->keys_ = std::move(merged);
+    }
+
+    size_t Erase(const K& key) {
+        Thaw();
+        size_t index = this->IndexOf(key);
+        if (index == this->Size()) {
+            return 0;
+        }
+        this->keys_.Erase(this->keys_.begin() + index);
+        return 1;
+    }
+
+    bool Contains(const K& key) const {
+        return this->IndexOf(key) != this->Size();
+    }
+
+    const_iterator Find(const K& key) const {
+        return begin() + this->IndexOf(key);
+    }
+
+    /* переставляет ключи в раскладку Эйтцингера для быстрого поиска */
+    void Freeze() {
+        if (!this->frozen_) {
+            detail::ApplyPermutation(this->keys_, detail::EytzingerOrder(this->Size()));
+            this->frozen_ = true;
+        }
+    }
+
+    /* возвращает отсортированный порядок */
+    void Thaw() {
+        if (this->frozen_) {
+            detail::ApplyPermutation(this->keys_,
+                    detail::InvertPermutation(detail::EytzingerOrder(this->Size())));
+            this->frozen_ = false;
+        }
+    }
+};
+
+/*
+    Словарь поверх двух параллельных self::Vector: ключи отдельно от значений,
+    поэтому поиск проходит только по плотному массиву ключей.
+    Сортировка, InsertMany и Freeze/Thaw устроены так же, как у FlatSet.
+    Указатели, возвращаемые Find и TryEmplace, действительны до следующего изменения
+*/
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap : public detail::SortedKeys<K, Compare> {
+    using Base = detail::SortedKeys<K, Compare>;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    FlatMap() = default;
+    explicit FlatMap(const Compare& comp)
+        : Base(comp) {}
+    FlatMap(std::initializer_list<std::pair<K, V>> items) {
+        InsertMany(items.begin(), items.end());
+    }
+
+    FlatMap(const FlatMap& other) = default;
+
+    FlatMap(FlatMap&& other) noexcept {
+        Swap(other);
+    }
+
+    FlatMap& operator=(const FlatMap& rhs) = default;
+
+    FlatMap& operator=(FlatMap&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    /* i-му ключу соответствует i-е значение */
+    self::Vector<V>& Values() noexcept {
+        return values_;
+    }
+    const self::Vector<V>& Values() const noexcept {
+        return values_;
+    }
+
+    void Reserve(size_t capacity) {
+        this->keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void Clear() {
+        this->keys_.Reset();
+        values_.Reset();
+        this->frozen_ = false;
+    }
+
+    void Swap(FlatMap& other) noexcept {
+        this->SwapKeys(other);
+        values_.Swap(other.values_);
+    }
+
+    /*
+        Вставляет (key, V(args...)), если ключа еще нет.
+        Возвращает указатель на значение с этим ключом и флаг вставки
+    */
+    template <typename KeyArg, typename... Args>
+    std::pair<V*, bool> TryEmplace(KeyArg&& key, Args&&... args) {
+        Thaw();
+        auto pos = this->LowerBound(key);
+        size_t index = static_cast<size_t>(pos - this->keys_.begin());
+        if (pos != this->keys_.end() && !this->comp_(key, *pos)) {
+            return {&values_[index], false};
+        }
+        values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        try {
+            this->keys_.Insert(pos, std::forward<KeyArg>(key));
+        } catch (...) {
+            values_.Erase(values_.begin() + index);
+            throw;
+        }
+        return {&values_[index], true};
+    }
+
+    V& operator[](const K& key) {
+        return *TryEmplace(key).first;
+    }
+
+    V& At(const K& key) {
+        V* value = Find(key);
+        if (!value) {
+            throw std::out_of_range("FlatMap key not found");
+        }
+        return *value;
+    }
+    const V& At(const K& key) const {
+        return const_cast<FlatMap&>(*this).At(key);
+    }
+
+    /* nullptr, если ключа нет */
+    V* Find(const K& key) {
+        size_t index = this->IndexOf(key);
+        return index == this->Size() ? nullptr : &values_[index];
+    }
+    const V* Find(const K& key) const {
+        return const_cast<FlatMap&>(*this).Find(key);
+    }
+
+    bool Contains(const K& key) const {
+        return this->IndexOf(key) != this->Size();
+    }
+
+    /*
+        Пакетная вставка пар (ключ, значение). Пачка стабильно сортируется
+        и сливается с имеющимися элементами за один проход; при повторе ключа
+        остается первое значение, уже имеющиеся не перезаписываются
+    */
+    template <typename InputIt>
+    void InsertMany(InputIt first, InputIt last) {
+        Thaw();
+        self::Vector<std::pair<K, V>> batch;
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            batch.Reserve(static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            batch.EmplaceBack(first->first, first->second);
+        }
+        std::stable_sort(batch.begin(), batch.end(), [this](const auto& lhs, const auto& rhs) {
+            return this->comp_(lhs.first, rhs.first);
+        });
+
+        self::Vector<K> merged_keys;
+        self::Vector<V> merged_values;
+        merged_keys.Reserve(this->Size() + batch.Size());
+        merged_values.Reserve(this->Size() + batch.Size());
+        size_t i = 0;
+        for (auto& [key, value] : batch) {
+            while (i < this->Size() && this->comp_(this->keys_[i], key)) {
+                merged_keys.PushBack(std::move(this->keys_[i]));
+                merged_values.PushBack(std::move(values_[i]));
+                ++i;
+            }
+            bool duplicate = (i < this->Size() && !this->comp_(key, this->keys_[i]))
+                    || (merged_keys.Size()
+                        && this->Equivalent(merged_keys[merged_keys.Size() - 1], key));
+            if (!duplicate) {
+                merged_keys.PushBack(std::move(key));
+                merged_values.PushBack(std::move(value));
+            }
+        }
+        for (; i < this->Size(); ++i) {
+            merged_keys.PushBack(std::move(this->keys_[i]));
+            merged_values.PushBack(std::move(values_[i]));
+        }
+        this->keys_ = std::move(merged_keys);
+        values_ = std::move(merged_values);
+    }
+
+    size_t Erase(const K& key) {
+        Thaw();
+        size_t index = this->IndexOf(key);
+        if (index == this->Size()) {
+            return 0;
+        }
+        this->keys_.Erase(this->keys_.begin() + index);
+        values_.Erase(values_.begin() + index);
+        return 1;
+    }
+
+    void Freeze() {
+        if (!this->frozen_) {
+            self::Vector<size_t> order = detail::EytzingerOrder(this->Size());
+            detail::ApplyPermutation(this->keys_, order);
+            detail::ApplyPermutation(values_, order);
+            this->frozen_ = true;
+        }
+    }
+
+    void Thaw() {
+        if (this->frozen_) {
+            self::Vector<size_t> order =
+                    detail::InvertPermutation(detail::EytzingerOrder(this->Size()));
+            detail::ApplyPermutation(this->keys_, order);
+            detail::ApplyPermutation(values_, order);
+            this->frozen_ = false;
+        }
+    }
+
+private:
+    self::Vector<V> values_;
+};
+
+template <typename K, typename Compare>
+void swap(FlatSet<K, Compare>& lhs, FlatSet<K, Compare>& rhs) noexcept {
+    lhs.Swap(rhs);
+}
+
+template <typename K, typename V, typename Compare>
+void swap(FlatMap<K, V, Compare>& lhs, FlatMap<K, V, Compare>& rhs) noexcept {
+    lhs.Swap(rhs);
+}
+
+} // self
\ No newline at end of file
@@ -0,0 +1,202 @@
+#pragma once
+#include <cstddef>
+#include <ostream>
+
+#ifdef SELF_CONTAINERS_INSTRUMENTATION
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+#endif
+
+/*
+    Счетчики аллокаций и роста контейнеров. Включаются макросом
+    SELF_CONTAINERS_INSTRUMENTATION (в CMake — опцией с тем же именем).
+    Без него SELF_INSTRUMENT раскрывается в ((void)0), а функции ниже
+    становятся пустыми, так что код контейнеров не меняется ни на байт
+*/
+namespace self::instrumentation {
+
+enum class Event {
+    Allocate,       // RawMemory выделила буфер, bytes — его размер
+    Deallocate,     // RawMemory освободила буфер
+    Reserve,        // Vector::Reserve переехал в буфер большего размера
+    OverflowPush,   // вставка в полный Vector вызвала удвоение емкости
+    NodeNew,        // список создал узел
+    NodeDelete,     // список удалил узел
+};
+
+struct EventInfo {
+    Event event;
+    const char* type_name;
+    /* размер выделенной/освобожденной памяти или новой емкости в байтах */
+    size_t bytes;
+    /* сколько байт элементов было перенесено (перемещено или скопировано) */
+    size_t bytes_copied;
+};
+
+/* пользовательский обработчик, вызывается на каждое событие; должен быть потокобезопасным */
+using Hook = void (*)(const EventInfo& info);
+
+#ifdef SELF_CONTAINERS_INSTRUMENTATION
+
+/* счетчики одного типа контейнера, например self::Vector<int> */
+struct Counters {
+    std::string type_name;
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+    std::atomic<size_t> bytes_allocated{0};
+    std::atomic<size_t> bytes_deallocated{0};
+    std::atomic<size_t> reserves{0};
+    std::atomic<size_t> overflow_pushes{0};
+    std::atomic<size_t> bytes_copied{0};
+    std::atomic<size_t> nodes_created{0};
+    std::atomic<size_t> nodes_destroyed{0};
+};
+
+namespace detail {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<const Counters*> counters;
+};
+
+/* намеренно не удаляется, чтобы отчет можно было снять в atexit после разрушения статиков */
+inline Registry& GetRegistry() {
+    static Registry* registry = new Registry;
+    return *registry;
+}
+
+inline std::atomic<Hook> hook{nullptr};
+
+template <typename Tag>
+std::string TypeName() {
+    const char* mangled = typeid(Tag).name();
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+#endif
+    return mangled;
+}
+
+} // detail
+
+template <typename Tag>
+Counters& CountersFor() {
+    static Counters* counters = [] {
+        auto* c = new Counters;
+        c->type_name = detail::TypeName<Tag>();
+        detail::Registry& registry = detail::GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        registry.counters.push_back(c);
+        return c;
+    }();
+    return *counters;
+}
+
+/* устанавливает обработчик событий (nullptr — отключить), возвращает предыдущий */
+inline Hook SetHook(Hook hook) {
+    return detail::hook.exchange(hook);
+}
+
+template <typename Tag>
+void Record(Event event, size_t bytes, size_t bytes_copied = 0) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    Counters& c = CountersFor<Tag>();
+    switch (event) {
+    case Event::Allocate:
+        c.allocations.fetch_add(1, relaxed);
+        c.bytes_allocated.fetch_add(bytes, relaxed);
+        break;
+    case Event::Deallocate:
+        c.deallocations.fetch_add(1, relaxed);
+        c.bytes_deallocated.fetch_add(bytes, relaxed);
+        break;
+    case Event::Reserve:
+        c.reserves.fetch_add(1, relaxed);
+        break;
+    case Event::OverflowPush:
+        c.overflow_pushes.fetch_add(1, relaxed);
+        break;
+    case Event::NodeNew:
+        c.nodes_created.fetch_add(1, relaxed);
+        c.bytes_allocated.fetch_add(bytes, relaxed);
+        break;
+    case Event::NodeDelete:
+        c.nodes_destroyed.fetch_add(1, relaxed);
+        c.bytes_deallocated.fetch_add(bytes, relaxed);
+        break;
+    }
+    c.bytes_copied.fetch_add(bytes_copied, relaxed);
+
+    if (Hook hook = detail::hook.load(std::memory_order_acquire)) {
+        hook(EventInfo{event, c.type_name.c_str(), bytes, bytes_copied});
+    }
+}
+
+/* печатает ненулевые счетчики всех типов, которые успели что-то записать */
+inline void DumpReport(std::ostream& out) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    detail::Registry& registry = detail::GetRegistry();
+    std::lock_guard lock(registry.mutex);
+    out << "self:: containers instrumentation report\n";
+    for (const Counters* c : registry.counters) {
+        out << "  " << c->type_name << '\n';
+        auto line = [&out](const char* name, size_t value) {
+            if (value != 0) {
+                out << "    " << name << ": " << value << '\n';
+            }
+        };
+        line("allocations", c->allocations.load(relaxed));
+        line("deallocations", c->deallocations.load(relaxed));
+        line("bytes allocated", c->bytes_allocated.load(relaxed));
+        line("bytes deallocated", c->bytes_deallocated.load(relaxed));
+        line("reserve growths", c->reserves.load(relaxed));
+        line("overflow pushes", c->overflow_pushes.load(relaxed));
+        line("bytes copied", c->bytes_copied.load(relaxed));
+        line("nodes created", c->nodes_created.load(relaxed));
+        line("nodes destroyed", c->nodes_destroyed.load(relaxed));
+    }
+}
+
+/* печатает отчет в stderr при завершении программы; повторные вызовы ничего не делают */
+inline void EnableReportAtExit() {
+    static const bool registered = [] {
+        std::atexit([] { DumpReport(std::cerr); });
+        return true;
+    }();
+    (void)registered;
+}
+
+#else
+
+inline Hook SetHook(Hook) {
+    return nullptr;
+}
+
+inline void DumpReport(std::ostream&) {}
+
+inline void EnableReportAtExit() {}
+
+#endif
+
+} // self::instrumentation
+
+/* SELF_INSTRUMENT(Tag, Event, bytes[, bytes_copied]) — точка записи события в контейнере */
+#ifdef SELF_CONTAINERS_INSTRUMENTATION
+#define SELF_INSTRUMENT(Tag, event, ...) \
+    ::self::instrumentation::Record<Tag>(::self::instrumentation::Event::event, __VA_ARGS__)
+#else
+#define SELF_INSTRUMENT(Tag, event, ...) ((void)0)
+#endif
\ No newline at end of file
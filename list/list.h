@@ -6,6 +6,8 @@
 #include <string>
 #include <utility>
 
+#include "instrumentation/instrumentation.h"
+
 
 namespace self {
 
@@ -115,7 +117,7 @@ public:
     void CreateAndSwap(const SingleLinkedList<Type>& other) {
         SingleLinkedList<Type> other_copy;
         Iterator temp_head = other_copy.before_begin();
-        for (const auto el : other) {
+        for (const auto& el : other) {
             temp_head = other_copy.InsertAfter(temp_head, el);
         }
         other_copy.size_ = other.size_;
@@ -139,6 +141,7 @@ public:
 
     void PushFront(const Type& value) {
         head_.next_node = new Node(value, head_.next_node);
+        SELF_INSTRUMENT(SingleLinkedList, NodeNew, sizeof(Node));
         ++size_;
     }
 
@@ -147,6 +150,7 @@ public:
         while (temp_node != nullptr) {
             head_.next_node = temp_node->next_node;
             delete temp_node;
+            SELF_INSTRUMENT(SingleLinkedList, NodeDelete, sizeof(Node));
             temp_node = head_.next_node;
         }
 
@@ -177,6 +181,7 @@ public:
             }
             insert_it = new Node(value, pos.node_->next_node);
             pos.node_->next_node = insert_it;
+            SELF_INSTRUMENT(SingleLinkedList, NodeNew, sizeof(Node));
             ++size_;
             return Iterator(insert_it);
         } catch(...) {
@@ -188,6 +193,7 @@ public:
     void PopFront() noexcept {
         Node* sec_node = head_.next_node->next_node;
         delete head_.next_node;
+        SELF_INSTRUMENT(SingleLinkedList, NodeDelete, sizeof(Node));
         head_.next_node = sec_node;
         --size_;
     }
@@ -206,6 +212,7 @@ public:
         }
         Node* next_next = next_node_ptr->next_node;
         delete next_node_ptr;
+        SELF_INSTRUMENT(SingleLinkedList, NodeDelete, sizeof(Node));
         --size_;
         pos.node_->next_node = next_next;
         return Iterator(next_next);
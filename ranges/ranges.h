@@ -0,0 +1,614 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "vector/vector.h"
+
+namespace self {
+
+/*
+    Ленивые адаптеры над любыми диапазонами с begin()/end(): self::Vector, self::Array,
+    SingleLinkedList и другими представлениями. Адаптеры ничего не вычисляют
+    и не выделяют память, пока их не обходят, а цепочка
+        vector | Filter(pred) | Transform(fn) | Take(n) | CollectInto(out)
+    проходит по исходным данным один раз, без промежуточных векторов.
+    Представление держит ссылку на lvalue-контейнер (он должен его пережить),
+    rvalue-контейнер или другое представление перемещается внутрь.
+    Size() у представления есть, только если размер известен без обхода.
+*/
+
+namespace detail {
+
+/* метка представлений: их копируют внутрь, а не берут по ссылке */
+struct ViewBase {};
+
+template <typename R>
+concept View = std::is_base_of_v<ViewBase, std::remove_cvref_t<R>>;
+
+/* размер без обхода: Size() у self::Vector и self::Array, GetSize() у SingleLinkedList */
+template <typename R>
+concept Sized = requires(const R& range) {
+    { range.Size() } -> std::convertible_to<size_t>;
+} || requires(const R& range) {
+    { range.GetSize() } -> std::convertible_to<size_t>;
+};
+
+template <Sized R>
+size_t SizeOf(const R& range) {
+    if constexpr (requires { range.Size(); }) {
+        return range.Size();
+    } else {
+        return range.GetSize();
+    }
+}
+
+template <typename R>
+using IteratorOf = decltype(std::declval<R&>().begin());
+
+template <typename It>
+using ReferenceOf = decltype(*std::declval<It&>());
+
+/* lvalue-контейнер: хранится указатель */
+template <typename R>
+class RefView : public ViewBase {
+public:
+    explicit RefView(R& range) noexcept
+        : range_(&range) {}
+
+    auto begin() const { return range_->begin(); }
+    auto end() const { return range_->end(); }
+
+    size_t Size() const requires Sized<R> {
+        return SizeOf(*range_);
+    }
+
+private:
+    R* range_;
+};
+
+/* rvalue-контейнер: перемещается внутрь представления */
+template <typename R>
+class OwningView : public ViewBase {
+public:
+    explicit OwningView(R&& range)
+        : range_(std::move(range)) {}
+
+    auto begin() const { return range_.begin(); }
+    auto end() const { return range_.end(); }
+
+    size_t Size() const requires Sized<R> {
+        return SizeOf(range_);
+    }
+
+private:
+    R range_;
+};
+
+template <typename R>
+auto AsView(R&& range) {
+    if constexpr (View<R>) {
+        return std::remove_cvref_t<R>(std::forward<R>(range));
+    } else if constexpr (std::is_lvalue_reference_v<R>) {
+        return RefView<std::remove_reference_t<R>>(range);
+    } else {
+        return OwningView<std::remove_cvref_t<R>>(std::move(range));
+    }
+}
+
+/* отложенный адаптер: range | adaptor вызывает make(range) */
+template <typename Make>
+struct Adaptor {
+    Make make;
+
+    template <typename R>
+    friend decltype(auto) operator|(R&& range, Adaptor adaptor) {
+        return adaptor.make(std::forward<R>(range));
+    }
+};
+
+template <typename Make>
+Adaptor(Make) -> Adaptor<Make>;
+
+/* сдвигает it не более чем на n шагов, не выходя за end; возвращает число шагов */
+template <typename It>
+size_t AdvanceUpTo(It& it, size_t n, const It& end) {
+    if constexpr (std::random_access_iterator<It>) {
+        const size_t steps = std::min(n, static_cast<size_t>(end - it));
+        it += static_cast<std::ptrdiff_t>(steps);
+        return steps;
+    } else {
+        size_t steps = 0;
+        for (; steps < n && it != end; ++steps) {
+            ++it;
+        }
+        return steps;
+    }
+}
+
+} // detail
+
+/* пара итераторов с известной длиной; элемент ChunkView */
+template <typename It>
+class Subrange : public detail::ViewBase {
+public:
+    Subrange() = default;
+    Subrange(It first, It last, size_t size)
+        : first_(first)
+        , last_(last)
+        , size_(size) {}
+
+    It begin() const { return first_; }
+    It end() const { return last_; }
+    size_t Size() const noexcept { return size_; }
+
+private:
+    It first_{};
+    It last_{};
+    size_t size_ = 0;
+};
+
+template <typename Base, typename Pred>
+class FilterView : public detail::ViewBase {
+    using BaseIterator = detail::IteratorOf<const Base>;
+
+public:
+    class Iterator {
+        friend class FilterView;
+
+        Iterator(BaseIterator it, BaseIterator end, const Pred* pred)
+            : it_(it)
+            , end_(end)
+            , pred_(pred) {
+            SkipRejected();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::iter_value_t<BaseIterator>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = detail::ReferenceOf<BaseIterator>;
+
+        Iterator() = default;
+
+        reference operator*() const { return *it_; }
+
+        Iterator& operator++() {
+            ++it_;
+            SkipRejected();
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& rhs) const { return it_ == rhs.it_; }
+
+    private:
+        void SkipRejected() {
+            while (it_ != end_ && !std::invoke(*pred_, *it_)) {
+                ++it_;
+            }
+        }
+
+        BaseIterator it_{};
+        BaseIterator end_{};
+        const Pred* pred_ = nullptr;
+    };
+
+    FilterView(Base base, Pred pred)
+        : base_(std::move(base))
+        , pred_(std::move(pred)) {}
+
+    /* каждый вызов begin() заново ищет первый подходящий элемент */
+    Iterator begin() const { return Iterator(base_.begin(), base_.end(), &pred_); }
+    Iterator end() const { return Iterator(base_.end(), base_.end(), &pred_); }
+
+private:
+    Base base_;
+    Pred pred_;
+};
+
+template <typename Base, typename Fn>
+class TransformView : public detail::ViewBase {
+    using BaseIterator = detail::IteratorOf<const Base>;
+
+public:
+    class Iterator {
+        friend class TransformView;
+
+        Iterator(BaseIterator it, const Fn* fn)
+            : it_(it)
+            , fn_(fn) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::invoke_result_t<const Fn&, detail::ReferenceOf<BaseIterator>>;
+        using value_type = std::remove_cvref_t<reference>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        Iterator() = default;
+
+        reference operator*() const { return std::invoke(*fn_, *it_); }
+
+        Iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy(*this);
+            ++it_;
+            return copy;
+        }
+
+        bool operator==(const Iterator& rhs) const { return it_ == rhs.it_; }
+
+    private:
+        BaseIterator it_{};
+        const Fn* fn_ = nullptr;
+    };
+
+    TransformView(Base base, Fn fn)
+        : base_(std::move(base))
+        , fn_(std::move(fn)) {}
+
+    Iterator begin() const { return Iterator(base_.begin(), &fn_); }
+    Iterator end() const { return Iterator(base_.end(), &fn_); }
+
+    size_t Size() const requires detail::Sized<Base> {
+        return detail::SizeOf(base_);
+    }
+
+private:
+    Base base_;
+    Fn fn_;
+};
+
+template <typename Base>
+class TakeView : public detail::ViewBase {
+    using BaseIterator = detail::IteratorOf<const Base>;
+
+public:
+    class Iterator {
+        friend class TakeView;
+
+        Iterator(BaseIterator it, BaseIterator end, size_t remaining)
+            : it_(it)
+            , end_(end)
+            , remaining_(remaining) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::iter_value_t<BaseIterator>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = detail::ReferenceOf<BaseIterator>;
+
+        Iterator() = default;
+
+        reference operator*() const { return *it_; }
+
+        /*
+            После последнего взятого элемента исходный итератор не двигается:
+            у Filter каждый шаг — это поиск следующего подходящего элемента
+        */
+        Iterator& operator++() {
+            if (--remaining_ != 0) {
+                ++it_;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        /* конец — либо взяли n элементов, либо кончился исходный диапазон */
+        bool operator==(const Iterator& rhs) const {
+            const bool done = IsDone();
+            return done == rhs.IsDone() && (done || it_ == rhs.it_);
+        }
+
+    private:
+        bool IsDone() const { return remaining_ == 0 || it_ == end_; }
+
+        BaseIterator it_{};
+        BaseIterator end_{};
+        size_t remaining_ = 0;
+    };
+
+    TakeView(Base base, size_t count)
+        : base_(std::move(base))
+        , count_(count) {}
+
+    Iterator begin() const { return Iterator(base_.begin(), base_.end(), count_); }
+    Iterator end() const { return Iterator(base_.end(), base_.end(), 0); }
+
+    size_t Size() const requires detail::Sized<Base> {
+        return std::min(count_, detail::SizeOf(base_));
+    }
+
+private:
+    Base base_;
+    size_t count_;
+};
+
+template <typename Base>
+class EnumerateView : public detail::ViewBase {
+    using BaseIterator = detail::IteratorOf<const Base>;
+
+public:
+    class Iterator {
+        friend class EnumerateView;
+
+        Iterator(BaseIterator it, size_t index)
+            : it_(it)
+            , index_(index) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::pair<size_t, detail::ReferenceOf<BaseIterator>>;
+        using value_type = reference;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        Iterator() = default;
+
+        reference operator*() const { return reference(index_, *it_); }
+
+        Iterator& operator++() {
+            ++it_;
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& rhs) const { return it_ == rhs.it_; }
+
+    private:
+        BaseIterator it_{};
+        size_t index_ = 0;
+    };
+
+    explicit EnumerateView(Base base)
+        : base_(std::move(base)) {}
+
+    Iterator begin() const { return Iterator(base_.begin(), 0); }
+    /* индекс у end() не важен: сравниваются только исходные итераторы */
+    Iterator end() const { return Iterator(base_.end(), 0); }
+
+    size_t Size() const requires detail::Sized<Base> {
+        return detail::SizeOf(base_);
+    }
+
+private:
+    Base base_;
+};
+
+template <typename First, typename Second>
+class ZipView : public detail::ViewBase {
+    using FirstIterator = detail::IteratorOf<const First>;
+    using SecondIterator = detail::IteratorOf<const Second>;
+
+public:
+    class Iterator {
+        friend class ZipView;
+
+        Iterator(FirstIterator first, FirstIterator first_end,
+                 SecondIterator second, SecondIterator second_end)
+            : first_(first)
+            , first_end_(first_end)
+            , second_(second)
+            , second_end_(second_end) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = std::pair<detail::ReferenceOf<FirstIterator>,
+                                    detail::ReferenceOf<SecondIterator>>;
+        using value_type = reference;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        Iterator() = default;
+
+        reference operator*() const { return reference(*first_, *second_); }
+
+        Iterator& operator++() {
+            ++first_;
+            ++second_;
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        /* обход останавливается на конце более короткого диапазона */
+        bool operator==(const Iterator& rhs) const {
+            const bool done = IsDone();
+            return done == rhs.IsDone() && (done || first_ == rhs.first_);
+        }
+
+    private:
+        bool IsDone() const { return first_ == first_end_ || second_ == second_end_; }
+
+        FirstIterator first_{};
+        FirstIterator first_end_{};
+        SecondIterator second_{};
+        SecondIterator second_end_{};
+    };
+
+    ZipView(First first, Second second)
+        : first_(std::move(first))
+        , second_(std::move(second)) {}
+
+    Iterator begin() const {
+        return Iterator(first_.begin(), first_.end(), second_.begin(), second_.end());
+    }
+    Iterator end() const {
+        return Iterator(first_.end(), first_.end(), second_.end(), second_.end());
+    }
+
+    size_t Size() const requires detail::Sized<First> && detail::Sized<Second> {
+        return std::min(detail::SizeOf(first_), detail::SizeOf(second_));
+    }
+
+private:
+    First first_;
+    Second second_;
+};
+
+template <typename Base>
+class ChunkView : public detail::ViewBase {
+    using BaseIterator = detail::IteratorOf<const Base>;
+
+public:
+    class Iterator {
+        friend class ChunkView;
+
+        Iterator(BaseIterator it, BaseIterator end, size_t chunk_size)
+            : it_(it)
+            , next_(it)
+            , end_(end)
+            , chunk_size_(chunk_size) {
+            FindNext();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Subrange<BaseIterator>;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        Iterator() = default;
+
+        reference operator*() const { return value_type(it_, next_, size_); }
+
+        Iterator& operator++() {
+            it_ = next_;
+            FindNext();
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& rhs) const { return it_ == rhs.it_; }
+
+    private:
+        void FindNext() {
+            size_ = detail::AdvanceUpTo(next_, chunk_size_, end_);
+        }
+
+        BaseIterator it_{};
+        BaseIterator next_{};
+        BaseIterator end_{};
+        size_t chunk_size_ = 0;
+        size_t size_ = 0;
+    };
+
+    ChunkView(Base base, size_t chunk_size)
+        : base_(std::move(base))
+        , chunk_size_(chunk_size) {
+        assert(chunk_size_ != 0);
+    }
+
+    Iterator begin() const { return Iterator(base_.begin(), base_.end(), chunk_size_); }
+    Iterator end() const { return Iterator(base_.end(), base_.end(), chunk_size_); }
+
+    size_t Size() const requires detail::Sized<Base> {
+        return (detail::SizeOf(base_) + chunk_size_ - 1) / chunk_size_;
+    }
+
+private:
+    Base base_;
+    size_t chunk_size_;
+};
+
+/* элементы, для которых pred истинен */
+template <typename Pred>
+auto Filter(Pred pred) {
+    return detail::Adaptor{[pred = std::move(pred)]<typename R>(R&& range) mutable {
+        auto base = detail::AsView(std::forward<R>(range));
+        return FilterView<decltype(base), Pred>(std::move(base), std::move(pred));
+    }};
+}
+
+/* fn(x) для каждого элемента; вычисляется при разыменовании */
+template <typename Fn>
+auto Transform(Fn fn) {
+    return detail::Adaptor{[fn = std::move(fn)]<typename R>(R&& range) mutable {
+        auto base = detail::AsView(std::forward<R>(range));
+        return TransformView<decltype(base), Fn>(std::move(base), std::move(fn));
+    }};
+}
+
+/* не больше count первых элементов; обход дальше не идет */
+inline auto Take(size_t count) {
+    return detail::Adaptor{[count]<typename R>(R&& range) {
+        auto base = detail::AsView(std::forward<R>(range));
+        return TakeView<decltype(base)>(std::move(base), count);
+    }};
+}
+
+/* пары (индекс, элемент) */
+inline auto Enumerate() {
+    return detail::Adaptor{[]<typename R>(R&& range) {
+        auto base = detail::AsView(std::forward<R>(range));
+        return EnumerateView<decltype(base)>(std::move(base));
+    }};
+}
+
+/* куски по chunk_size элементов (последний может быть короче) в виде Subrange */
+inline auto Chunk(size_t chunk_size) {
+    return detail::Adaptor{[chunk_size]<typename R>(R&& range) {
+        auto base = detail::AsView(std::forward<R>(range));
+        return ChunkView<decltype(base)>(std::move(base), chunk_size);
+    }};
+}
+
+/* пары (first[i], second[i]) до конца более короткого диапазона */
+template <typename R1, typename R2>
+auto Zip(R1&& first, R2&& second) {
+    auto first_view = detail::AsView(std::forward<R1>(first));
+    auto second_view = detail::AsView(std::forward<R2>(second));
+    return ZipView<decltype(first_view), decltype(second_view)>(
+            std::move(first_view), std::move(second_view));
+}
+
+/*
+    Завершает цепочку: дописывает элементы в конец out и возвращает out.
+    Если размер диапазона известен, память резервируется один раз и ровно под него
+*/
+template <typename T>
+auto CollectInto(Vector<T>& out) {
+    return detail::Adaptor{[&out]<typename R>(R&& range) -> Vector<T>& {
+        if constexpr (detail::Sized<std::remove_cvref_t<R>>) {
+            out.Reserve(out.Size() + detail::SizeOf(range));
+        }
+        for (auto&& value : range) {
+            out.PushBack(std::forward<decltype(value)>(value));
+        }
+        return out;
+    }};
+}
+
+} // self
@@ -0,0 +1,409 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "array/array.h"
+#include "bit_vector/bit_vector.h"
+#include "vector/vector.h"
+
+namespace self {
+
+namespace detail {
+
+/* с какого слота читателя поток начинает поиск: потоки расходятся по разным слотам */
+inline size_t ReaderSlotHint() noexcept {
+    static std::atomic<size_t> next{0};
+    thread_local const size_t hint = next.fetch_add(1, std::memory_order_relaxed);
+    return hint;
+}
+
+} // detail
+
+/*
+    Вектор для схемы "один писатель, много читателей" в стиле RCU.
+    Данные разбиты на куски по kChunkSize элементов, каждый кусок — self::Vector<T>
+    под shared_ptr. Читатели берут Load() — неизменяемый снимок — и дальше читают
+    его без какой-либо синхронизации, сколько угодно долго.
+    Load() lock-free: текущая версия — атомарный указатель, а чтобы писатель не
+    освободил ее между загрузкой указателя и захватом ссылки, читатель на это
+    время объявляет ее в своем слоте (hazard pointer). Слоты выровнены по кэш-линии,
+    и потоки начинают с разных слотов, так что читатели не делят строку друг с другом
+    и никогда не ждут писателя. Общая запись у Load() одна — инкремент счетчика
+    снимков версии. Писатель меняет черновик: кусок, общий с уже опубликованными
+    версиями, копируется при первой записи после публикации, остальные куски
+    остаются общими. Publish() атомарно подменяет текущую версию, а старую
+    откладывает; отложенные версии, которые никто не держит и не объявил в слоте,
+    освобождает следующий Publish() (или деструктор). Цена публикации —
+    O(число кусков) копий указателей, а не O(n) копий элементов.
+    Методы писателя (все, кроме Load) нельзя вызывать из нескольких потоков сразу,
+    снимки не должны пережить сам SnapshotVector
+*/
+template <typename T>
+class SnapshotVector {
+    /* элементов в куске: около 4 КиБ, но не меньше 16 */
+    static constexpr size_t kChunkSize = std::bit_floor(std::max<size_t>(16, 4096 / sizeof(T)));
+    /*
+        одновременных Load(); слот занят только на время самого Load(),
+        при занятых всех слотах читатель перебирает их по кругу
+    */
+    static constexpr size_t kReaderSlots = 64;
+
+    using Chunk = self::Vector<T>;
+
+    /* опубликованная версия: набор неизменяемых кусков */
+    struct Version {
+        self::Vector<std::shared_ptr<const Chunk>> chunks;
+        size_t size = 0;
+        /* число живых снимков; версию освобождает только писатель */
+        mutable std::atomic<size_t> snapshots{0};
+    };
+
+    /* версия, которую читатель сейчас захватывает */
+    struct alignas(kCacheLineSize) ReaderSlot {
+        std::atomic<const Version*> version{nullptr};
+    };
+
+public:
+    using value_type = T;
+
+    /* неизменяемый снимок; копирование — инкремент счетчика снимков версии */
+    class Snapshot {
+        friend class SnapshotVector;
+
+        /* версия уже защищена от освобождения: слотом читателя или самим писателем */
+        explicit Snapshot(const Version* version) noexcept
+            : version_(version) {
+            version_->snapshots.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    public:
+        Snapshot(const Snapshot& other) noexcept
+            : Snapshot(other.version_) {}
+        Snapshot(Snapshot&& other) noexcept
+            : version_(std::exchange(other.version_, nullptr)) {}
+
+        Snapshot& operator=(Snapshot other) noexcept {
+            std::swap(version_, other.version_);
+            return *this;
+        }
+
+        ~Snapshot() {
+            if (version_) {
+                /* release: чтения снимка завершены до того, как писатель освободит версию */
+                version_->snapshots.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        class Iterator {
+            friend class Snapshot;
+
+            Iterator(const Version* version, size_t index) noexcept
+                : version_(version)
+                , index_(index) {}
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            Iterator() = default;
+
+            [[nodiscard]] reference operator*() const noexcept {
+                return At(index_);
+            }
+            [[nodiscard]] pointer operator->() const noexcept {
+                return &At(index_);
+            }
+            [[nodiscard]] reference operator[](difference_type n) const noexcept {
+                return At(index_ + n);
+            }
+
+            Iterator& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+            Iterator operator++(int) noexcept {
+                auto copy(*this);
+                ++index_;
+                return copy;
+            }
+            Iterator& operator--() noexcept {
+                --index_;
+                return *this;
+            }
+            Iterator operator--(int) noexcept {
+                auto copy(*this);
+                --index_;
+                return copy;
+            }
+            Iterator& operator+=(difference_type n) noexcept {
+                index_ += n;
+                return *this;
+            }
+            Iterator& operator-=(difference_type n) noexcept {
+                index_ -= n;
+                return *this;
+            }
+            [[nodiscard]] friend Iterator operator+(Iterator it, difference_type n) noexcept {
+                return it += n;
+            }
+            [[nodiscard]] friend Iterator operator+(difference_type n, Iterator it) noexcept {
+                return it += n;
+            }
+            [[nodiscard]] friend Iterator operator-(Iterator it, difference_type n) noexcept {
+                return it -= n;
+            }
+            [[nodiscard]] friend difference_type operator-(const Iterator& lhs,
+                                                           const Iterator& rhs) noexcept {
+                return static_cast<difference_type>(lhs.index_)
+                       - static_cast<difference_type>(rhs.index_);
+            }
+
+            [[nodiscard]] bool operator==(const Iterator& rhs) const noexcept {
+                return index_ == rhs.index_;
+            }
+            [[nodiscard]] auto operator<=>(const Iterator& rhs) const noexcept {
+                return index_ <=> rhs.index_;
+            }
+
+        private:
+            const T& At(size_t index) const noexcept {
+                return (*version_->chunks[index / kChunkSize])[index % kChunkSize];
+            }
+
+            const Version* version_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        using const_iterator = Iterator;
+
+        [[nodiscard]] Iterator begin() const noexcept {
+            return Iterator(version_, 0);
+        }
+        [[nodiscard]] Iterator end() const noexcept {
+            return Iterator(version_, version_->size);
+        }
+        [[nodiscard]] Iterator cbegin() const noexcept {
+            return begin();
+        }
+        [[nodiscard]] Iterator cend() const noexcept {
+            return end();
+        }
+
+        [[nodiscard]] size_t Size() const noexcept {
+            return version_->size;
+        }
+        [[nodiscard]] bool IsEmpty() const noexcept {
+            return version_->size == 0;
+        }
+
+        const T& operator[](size_t index) const noexcept {
+            assert(index < version_->size);
+            return (*version_->chunks[index / kChunkSize])[index % kChunkSize];
+        }
+        const T& At(size_t index) const {
+            if (index >= version_->size) {
+                throw std::out_of_range("Snapshot index out of range");
+            }
+            return (*this)[index];
+        }
+
+    private:
+        const Version* version_ = nullptr;
+    };
+
+    SnapshotVector()
+        : current_(new Version) {}
+
+    /* версии могут удерживать читатели, поэтому сам объект не копируется и не перемещается */
+    SnapshotVector(const SnapshotVector&) = delete;
+    SnapshotVector& operator=(const SnapshotVector&) = delete;
+
+    ~SnapshotVector() {
+        for (const Version* version : retired_) {
+            assert(version->snapshots.load() == 0 && "Snapshot outlived SnapshotVector");
+            delete version;
+        }
+        assert(current_.load()->snapshots.load() == 0 && "Snapshot outlived SnapshotVector");
+        delete current_.load();
+    }
+
+    /*
+        Вызывается читателями из любых потоков, lock-free. Все операции со слотом и
+        current_ — seq_cst: писатель подменяет current_ раньше, чем просматривает слоты,
+        а читатель объявляет версию раньше, чем проверяет, что она все еще текущая.
+        Поэтому писатель либо увидит объявленную версию, либо читатель увидит новую
+    */
+    [[nodiscard]] Snapshot Load() const noexcept {
+        const Version* version = current_.load();
+        ReaderSlot& slot = ClaimSlot(version);
+        for (const Version* now = current_.load(); now != version; now = current_.load()) {
+            version = now;
+            slot.version.store(version);
+        }
+        Snapshot snapshot(version);
+        slot.version.store(nullptr);
+        return snapshot;
+    }
+
+    /* делает черновик видимым читателям и возвращает его снимок */
+    Snapshot Publish() {
+        auto version = std::make_unique<Version>();
+        version->chunks.Reserve(chunks_.Size());
+        for (const auto& chunk : chunks_) {
+            version->chunks.PushBack(std::shared_ptr<const Chunk>(chunk));
+        }
+        version->size = size_;
+        /* место под старую версию заранее: после обмена исключений быть не должно */
+        if (retired_.Size() == retired_.Capacity()) {
+            retired_.Reserve(std::max<size_t>(4, retired_.Capacity() * 2));
+        }
+        const Version* published = version.release();
+        retired_.PushBack(current_.exchange(published));
+        /* теперь все куски общие с опубликованной версией */
+        owned_ = BitVector(chunks_.Size());
+        Reclaim();
+        return Snapshot(published);
+    }
+
+    /* ниже — методы писателя; они работают с черновиком */
+    [[nodiscard]] size_t Size() const noexcept {
+        return size_;
+    }
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (*chunks_[index / kChunkSize])[index % kChunkSize];
+    }
+
+    /*
+        Ссылка для изменения на месте; копирует кусок, если он общий с опубликованной
+        версией. Ссылка действительна только до следующего Publish(): после него кусок
+        становится общим, и запись через нее изменила бы данные, которые видят читатели.
+        То же относится к ссылке, которую возвращает EmplaceBack
+    */
+    T& Mutable(size_t index) {
+        assert(index < size_);
+        return (*OwnedChunk(index / kChunkSize))[index % kChunkSize];
+    }
+
+    template <typename U>
+    void Set(size_t index, U&& value) {
+        Mutable(index) = std::forward<U>(value);
+    }
+
+    /* так же, как у Vector: универсальная ссылка вместо пары перегрузок */
+    template <typename U>
+    void PushBack(U&& value) {
+        EmplaceBack(std::forward<U>(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ % kChunkSize == 0) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->Reserve(kChunkSize);
+            chunks_.PushBack(std::move(chunk));
+            owned_.PushBack(true);
+        }
+        T& value = OwnedChunk(chunks_.Size() - 1)->EmplaceBack(std::forward<Args>(args)...);
+        ++size_;
+        return value;
+    }
+
+    void PopBack() {
+        assert(size_ != 0);
+        const size_t last = chunks_.Size() - 1;
+        if (size_ % kChunkSize == 1) {
+            /* кусок опустеет целиком — копировать его незачем */
+            chunks_.PopBack();
+            owned_.PopBack();
+        } else {
+            OwnedChunk(last)->PopBack();
+        }
+        --size_;
+    }
+
+    void Clear() noexcept {
+        chunks_.Reset();
+        owned_.Reset();
+        size_ = 0;
+    }
+
+private:
+    static_assert(std::atomic<const Version*>::is_always_lock_free);
+
+    std::atomic<const Version*> current_;
+    mutable self::Array<ReaderSlot, kReaderSlots> slots_;
+    /* замененные версии, которые еще могут держать читатели */
+    self::Vector<const Version*> retired_;
+    /* черновик писателя */
+    self::Vector<std::shared_ptr<Chunk>> chunks_;
+    /* owned_[i] — кусок i принадлежит только черновику, и его можно менять на месте */
+    BitVector owned_;
+    size_t size_ = 0;
+
+private:
+    /* занимает свободный слот под version; слот освобождается в конце Load() */
+    ReaderSlot& ClaimSlot(const Version* version) const noexcept {
+        for (size_t i = detail::ReaderSlotHint();; ++i) {
+            ReaderSlot& slot = slots_[i % kReaderSlots];
+            const Version* expected = nullptr;
+            if (slot.version.load(std::memory_order_relaxed) == nullptr
+                    && slot.version.compare_exchange_strong(expected, version)) {
+                return slot;
+            }
+        }
+    }
+
+    /*
+        Освобождает замененные версии без снимков, которые не объявлены ни в одном слоте.
+        Слоты читаются раньше счетчиков: если читатель успел захватить снимок и освободить
+        слот, то acquire-чтение слота гарантирует, что его инкремент уже виден
+    */
+    void Reclaim() {
+        self::Array<const Version*, kReaderSlots> hazards;
+        for (size_t i = 0; i < kReaderSlots; ++i) {
+            hazards[i] = slots_[i].version.load();
+        }
+        size_t kept = 0;
+        for (const Version* version : retired_) {
+            const bool in_use = version->snapshots.load(std::memory_order_acquire) != 0
+                    || std::find(hazards.begin(), hazards.end(), version) != hazards.end();
+            if (in_use) {
+                retired_[kept++] = version;
+            } else {
+                delete version;
+            }
+        }
+        retired_.Resize(kept);
+    }
+
+    std::shared_ptr<Chunk>& OwnedChunk(size_t chunk) {
+        if (!owned_[chunk]) {
+            auto copy = std::make_shared<Chunk>();
+            copy->Reserve(kChunkSize);
+            for (const T& value : *chunks_[chunk]) {
+                copy->PushBack(value);
+            }
+            chunks_[chunk] = std::move(copy);
+            owned_.Set(chunk);
+        }
+        return chunks_[chunk];
+    }
+};
+
+} // self
\ No newline at end of file
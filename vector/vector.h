@@ -6,6 +6,8 @@
 #include <memory>
 #include <utility>
 
+#include "instrumentation/instrumentation.h"
+
 template <typename T>
 class RawMemory {
 public:
@@ -76,10 +78,17 @@ private:
 
 private:
     static T* Allocate(size_t nn) {
-        return nn == 0 ? nullptr : static_cast<T*>(operator new(sizeof(T) * nn));
+        if (nn == 0) {
+            return nullptr;
+        }
+        T* data = static_cast<T*>(operator new(sizeof(T) * nn));
+        /* событие только после успешного выделения: bad_alloc не должен попасть в счетчики */
+        SELF_INSTRUMENT(RawMemory, Allocate, sizeof(T) * nn);
+        return data;
     }
 
     void Deallocate(T* data) {
+        SELF_INSTRUMENT(RawMemory, Deallocate, sizeof(T) * capacity_);
         operator delete(data);
         data = nullptr;
     }
@@ -102,7 +111,8 @@ public:
             , size_(other.size_) {
         std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
     }
-    Vector(Vector&& other) : data_(std::move(other.data_)), size_(other.size_) {}
+    /* буфер уходит целиком, источник остается пустым */
+    Vector(Vector&& other) noexcept : data_(std::move(other.data_)), size_(std::exchange(other.size_, 0)) {}
 
     ~Vector() {
         Reset();
@@ -196,6 +206,7 @@ public:
 
         if (capacity > data_.Capacity()) {
             RawMemory<T> buffer(capacity);
+            SELF_INSTRUMENT(Vector, Reserve, sizeof(T) * capacity, sizeof(T) * size_);
             MoveOrCopyUninitialized(data_.GetAddress(), size_, buffer.GetAddress());
 
             std::destroy_n(data_.GetAddress(), size_);
@@ -208,7 +219,7 @@ public:
             Reset();
             return;
         } else if (new_size < size_) {
-            std::destroy_n(data_.GetAddress(), size_ - new_size);
+            std::destroy_n(data_ + new_size, size_ - new_size);
         } else {
             Reserve(new_size);
             std::uninitialized_value_construct_n(
@@ -246,11 +257,14 @@ public:
                 new (position) T(std::forward<Args>(args)...);
                 ++size_;
             } else {
-                T* temp = new T(std::forward<Args>(args)...);
-                MoveOrCopyBackward(position, end(), end()+1);
-                *position = std::move(*temp);
+                /* аргументы могут ссылаться на элемент самого вектора,
+                   поэтому значение создается до сдвига */
+                T temp(std::forward<Args>(args)...);
+                /* end() — сырая память, туда можно только конструировать */
+                MoveOrCopyUninitialized(end() - 1, 1, end());
+                MoveOrCopyBackward(position, end() - 1, end());
+                *position = std::move(temp);
                 ++size_;
-                delete temp;
             }
         }
         return data_ + dist;
@@ -314,6 +328,7 @@ private:
     void OverflowPush(size_t pos_n, U&&... val) {
         RawMemory<T> buffer(size_ == 0 ? 1 : size_ * 2);
         new (buffer + pos_n) T(std::forward<U>(val)...);
+        SELF_INSTRUMENT(Vector, OverflowPush, sizeof(T) * buffer.Capacity(), sizeof(T) * size_);
         
         /* до pos */
         MoveOrCopyUninitialized(data_.GetAddress(), pos_n